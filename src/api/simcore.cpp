@@ -0,0 +1,160 @@
+/**
+ * @file simcore.cpp
+ * @brief Implementación de la API en C sobre Grid2D y Simulator
+ */
+
+#include "simcore.h"
+#include "core/Grid2D.hpp"
+#include "core/Rules.hpp"
+#include "core/Simulator.hpp"
+#include <exception>
+#include <new>
+#include <optional>
+
+struct simcore_universe {
+    Core::Grid2D grid;
+    Core::Simulator simulator;  // Guarda una referencia a grid: va después
+
+    simcore_universe(int width, int height, Core::GridLayout layout) : grid(width, height, layout), simulator(grid) { }
+};
+
+namespace {
+
+/**
+ * @brief Ejecuta una operación sin dejar escapar excepciones hacia C
+ * @param universe Universo (error si es NULL)
+ * @param operation Función que recibe el universo y devuelve un estado
+ * @return Estado de la operación, o el error de la excepción
+ */
+template <typename F>
+simcore_status guarded(simcore_universe* universe, F&& operation)
+{
+    if (!universe)
+        return SIMCORE_ERROR_INVALID_ARGUMENT;
+    try {
+        return operation(*universe);
+    } catch (const std::bad_alloc&) {
+        return SIMCORE_ERROR_OUT_OF_MEMORY;
+    } catch (...) {
+        return SIMCORE_ERROR_INTERNAL;
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+simcore_universe* simcore_create(int32_t width, int32_t height, const char* rule, int32_t layout)
+{
+    if (width <= 0 || height <= 0 || (layout != SIMCORE_LAYOUT_BYTES && layout != SIMCORE_LAYOUT_BITS))
+        return nullptr;
+    std::optional<Core::Rule> parsed = Core::Rules::fromType(Core::RuleType::CONWAY);
+    if (rule)
+        parsed = Core::Rules::parse(rule);
+    if (!parsed)
+        return nullptr;
+
+    try {
+        Core::GridLayout gridLayout = layout == SIMCORE_LAYOUT_BITS ? Core::GridLayout::BITS : Core::GridLayout::BYTES;
+        simcore_universe* universe = new simcore_universe(width, height, gridLayout);
+        universe->simulator.setRule(*parsed);
+        return universe;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void simcore_destroy(simcore_universe* universe)
+{
+    delete universe;
+}
+
+simcore_status simcore_set_thread_count(simcore_universe* universe, int32_t thread_count)
+{
+    return guarded(universe, [&](simcore_universe& u) {
+        if (thread_count < 0)
+            return SIMCORE_ERROR_INVALID_ARGUMENT;
+        u.simulator.setThreadCount(thread_count);
+        return SIMCORE_OK;
+    });
+}
+
+simcore_status simcore_set_boundary(simcore_universe* universe, int32_t boundary)
+{
+    return guarded(universe, [&](simcore_universe& u) {
+        if (boundary < 0 || boundary >= static_cast<int32_t>(Core::BoundaryMode::COUNT))
+            return SIMCORE_ERROR_INVALID_ARGUMENT;
+        u.grid.setBoundary(static_cast<Core::BoundaryMode>(boundary));
+        return SIMCORE_OK;
+    });
+}
+
+simcore_status simcore_randomize(simcore_universe* universe, float density, uint64_t seed)
+{
+    return guarded(universe, [&](simcore_universe& u) {
+        if (!(density >= 0.0f && density <= 1.0f))
+            return SIMCORE_ERROR_INVALID_ARGUMENT;
+        u.grid.randomize(density, seed);
+        return SIMCORE_OK;
+    });
+}
+
+simcore_status simcore_set_cell(simcore_universe* universe, int32_t x, int32_t y, uint8_t state)
+{
+    return guarded(universe, [&](simcore_universe& u) {
+        if (x < 0 || y < 0 || x >= u.grid.getWidth() || y >= u.grid.getHeight() || state >= u.grid.getStateCount())
+            return SIMCORE_ERROR_INVALID_ARGUMENT;
+        u.grid.setCell(x, y, static_cast<Core::CellState>(state));
+        return SIMCORE_OK;
+    });
+}
+
+simcore_status simcore_step(simcore_universe* universe, int64_t generations)
+{
+    return guarded(universe, [&](simcore_universe& u) {
+        if (generations < 0)
+            return SIMCORE_ERROR_INVALID_ARGUMENT;
+        const int64_t target = u.simulator.getGeneration() + generations;
+        while (u.simulator.getGeneration() < target && !u.simulator.fastForward(target))
+            u.simulator.step();
+        return SIMCORE_OK;
+    });
+}
+
+int64_t simcore_get_generation(const simcore_universe* universe)
+{
+    return universe ? universe->simulator.getGeneration() : -1;
+}
+
+int64_t simcore_get_population(const simcore_universe* universe)
+{
+    return universe ? universe->grid.getPopulation() : -1;
+}
+
+simcore_status simcore_get_buffer(const simcore_universe* universe, simcore_buffer* buffer)
+{
+    if (!universe || !buffer)
+        return SIMCORE_ERROR_INVALID_ARGUMENT;
+
+    const Core::Grid2D& grid = universe->grid;
+    buffer->width = grid.getWidth();
+    buffer->height = grid.getHeight();
+    buffer->revision = grid.getRevision();
+    if (grid.getLayout() == Core::GridLayout::BITS) {
+        const int64_t planeBytes = static_cast<int64_t>(grid.getBitStride()) * sizeof(uint64_t);
+        buffer->cells = grid.getBitRow(0);
+        buffer->layout = SIMCORE_LAYOUT_BITS;
+        buffer->planes = grid.getPlaneCount();
+        buffer->row_stride = planeBytes * grid.getPlaneCount();
+        buffer->plane_stride = planeBytes;
+    } else {
+        buffer->cells = grid.getByteRow(0);
+        buffer->layout = SIMCORE_LAYOUT_BYTES;
+        buffer->planes = 1;
+        buffer->row_stride = grid.getByteStride();
+        buffer->plane_stride = 0;
+    }
+    return SIMCORE_OK;
+}
+
+}  // extern "C"
@@ -0,0 +1,175 @@
+/**
+ * @file simcore.h
+ * @brief API en C de la biblioteca simcore
+ *
+ * Permite crear y avanzar un universo desde cualquier lenguaje con FFI en C
+ * y leer sus celdas sin copias: simcore_get_buffer() describe el buffer
+ * frontal del grid (puntero, layout y distancias entre filas y planos).
+ * Ninguna función lanza excepciones; las que pueden fallar devuelven un
+ * simcore_status. Un universo no debe usarse desde dos hilos a la vez.
+ */
+
+#ifndef SIMCORE_H
+#define SIMCORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// La biblioteca se compila con visibilidad oculta: solo se exportan las funciones simcore_*
+#if defined(_WIN32) && defined(SIMCORE_BUILD)
+#define SIMCORE_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#define SIMCORE_API __attribute__((visibility("default")))
+#else
+#define SIMCORE_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Resultado de las funciones que pueden fallar
+ */
+typedef enum simcore_status {
+    SIMCORE_OK = 0,
+    SIMCORE_ERROR_INVALID_ARGUMENT = -1,  // Universo nulo, tamaño, regla o celda no válidos
+    SIMCORE_ERROR_OUT_OF_MEMORY = -2,
+    SIMCORE_ERROR_INTERNAL = -3
+} simcore_status;
+
+/**
+ * @brief Almacenamiento de las celdas (ver simcore_buffer)
+ */
+typedef enum simcore_layout {
+    SIMCORE_LAYOUT_BYTES = 0,  // Un byte por celda con su estado
+    SIMCORE_LAYOUT_BITS = 1    // 64 celdas por palabra de 64 bits, un plano por bit del estado
+} simcore_layout;
+
+/**
+ * @brief Tratamiento de los vecinos fuera del grid
+ */
+typedef enum simcore_boundary {
+    SIMCORE_BOUNDARY_DEAD = 0,   // Celdas muertas
+    SIMCORE_BOUNDARY_TORUS = 1,  // El borde opuesto
+    SIMCORE_BOUNDARY_MIRROR = 2  // Reflejo incluyendo el borde
+} simcore_boundary;
+
+/**
+ * @brief Vista de solo lectura del estado actual del grid
+ *
+ * BYTES: el estado de (x, y) es ((const uint8_t*)cells)[y * row_stride + x].
+ * BITS: el bit p del estado de (x, y) es el bit x % 64 de la palabra
+ * x / 64 de la fila que empieza en (const char*)cells + y * row_stride +
+ * p * plane_stride; los bits de relleno de la última palabra no son celdas.
+ *
+ * El puntero vale hasta la siguiente llamada que modifique el universo
+ * (paso, edición o destrucción): los pasos intercambian el buffer frontal
+ * con el trasero. revision cambia con cada modificación.
+ */
+typedef struct simcore_buffer {
+    const void* cells;     // Celda (0, 0)
+    int32_t layout;        // simcore_layout
+    int32_t width;
+    int32_t height;
+    int32_t planes;        // Planos por fila (1 en BYTES)
+    int64_t row_stride;    // Bytes entre el comienzo de dos filas consecutivas
+    int64_t plane_stride;  // Bytes entre dos planos de la misma fila (0 en BYTES)
+    uint64_t revision;
+} simcore_buffer;
+
+/**
+ * @brief Universo opaco: grid y simulador
+ */
+typedef struct simcore_universe simcore_universe;
+
+/**
+ * @brief Crea un universo vacío
+ * @param width Ancho (> 0)
+ * @param height Alto (> 0)
+ * @param rule Regla en notación B/S, Generations o Larger than Life ("B3/S23" si es NULL)
+ * @param layout simcore_layout
+ * @return Universo, o NULL si algún parámetro no es válido o no hay memoria
+ */
+SIMCORE_API simcore_universe* simcore_create(int32_t width, int32_t height, const char* rule, int32_t layout);
+
+/**
+ * @brief Destruye un universo (NULL no hace nada)
+ * @param universe Universo
+ */
+SIMCORE_API void simcore_destroy(simcore_universe* universe);
+
+/**
+ * @brief Establece los hilos que reparten cada paso
+ * @param universe Universo
+ * @param thread_count Hilos incluyendo al llamador (0 = núcleos disponibles)
+ * @return SIMCORE_OK o un error
+ */
+SIMCORE_API simcore_status simcore_set_thread_count(simcore_universe* universe, int32_t thread_count);
+
+/**
+ * @brief Establece el tratamiento de los bordes
+ * @param universe Universo
+ * @param boundary simcore_boundary
+ * @return SIMCORE_OK o un error
+ */
+SIMCORE_API simcore_status simcore_set_boundary(simcore_universe* universe, int32_t boundary);
+
+/**
+ * @brief Llena el grid con una sopa aleatoria reproducible
+ * @param universe Universo
+ * @param density Probabilidad de cada celda viva (0 a 1)
+ * @param seed Semilla
+ * @return SIMCORE_OK o un error
+ */
+SIMCORE_API simcore_status simcore_randomize(simcore_universe* universe, float density, uint64_t seed);
+
+/**
+ * @brief Establece el estado de una celda
+ * @param universe Universo
+ * @param x Columna
+ * @param y Fila
+ * @param state Estado (0 = muerta, 1 = viva, 2.. = estados de Generations)
+ * @return SIMCORE_OK o un error
+ */
+SIMCORE_API simcore_status simcore_set_cell(simcore_universe* universe, int32_t x, int32_t y, uint8_t state);
+
+/**
+ * @brief Avanza el universo
+ *
+ * Si el grid entra en un ciclo, los periodos completos se saltan sin
+ * simularlos.
+ *
+ * @param universe Universo
+ * @param generations Generaciones a avanzar (>= 0)
+ * @return SIMCORE_OK o un error
+ */
+SIMCORE_API simcore_status simcore_step(simcore_universe* universe, int64_t generations);
+
+/**
+ * @brief Obtiene la generación actual
+ * @param universe Universo
+ * @return Generación, o -1 si universe es NULL
+ */
+SIMCORE_API int64_t simcore_get_generation(const simcore_universe* universe);
+
+/**
+ * @brief Obtiene el número de celdas vivas
+ * @param universe Universo
+ * @return Población, o -1 si universe es NULL
+ */
+SIMCORE_API int64_t simcore_get_population(const simcore_universe* universe);
+
+/**
+ * @brief Describe el buffer de celdas actual, sin copiarlo
+ * @param universe Universo
+ * @param buffer Recibe la descripción
+ * @return SIMCORE_OK o un error
+ */
+SIMCORE_API simcore_status simcore_get_buffer(const simcore_universe* universe, simcore_buffer* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SIMCORE_H
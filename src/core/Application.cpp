@@ -6,6 +6,7 @@
 #include <GL/glew.h>
 #include "Application.hpp"
 #include "FileFinder.hpp"
+#include "renderer/Texture.hpp"
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -17,7 +18,8 @@ namespace Core {
 static const char* const MODELS_DIRECTORY = "assets/models";
 
 Application::Application(int width, int height, const std::string& title) :
-    width(width), height(height), title(title), lastFrame(0.0f), deltaTime(0.0f)
+    gridTexture(0), gridTextureRevision(0), width(width), height(height), title(title), lastFrame(0.0f),
+    deltaTime(0.0f)
 {
 }
 
@@ -41,16 +43,23 @@ void Application::init()
     // Nota: InputManager se crea después del grid y simulator
 
     // Crear grid de simulación (20x20)
-    grid = std::make_unique<Grid2D>(20, 20);
+    grid = std::make_unique<Grid2D>(20, 20, GridLayout::BITS);
     grid->randomize(0.3f);  // 30% de celdas vivas
 
     // Crear simulador
     simulator = std::make_unique<Simulator>(*grid);
     simulator->setSpeed(5.0f);  // 5 pasos por segundo
 
+    // Desde aquí solo el hilo de simulación toca grid y simulator; el resto lee instantáneas
+    simulation = std::make_unique<SimulationThread>(*simulator, *grid);
+
     // Crear estadísticas
     stats = std::make_unique<Stats>();
 
+    // Textura del grid (se rellena en el primer frame)
+    gridTexture = Renderer::TextureLoader::createDynamic(grid->getWidth(), grid->getHeight());
+    gridTextureRevision = grid->getRevision() - 1;
+
     // Cargar todos los modelos 3D de la carpeta assets/models/
     std::cout << "Loading models from: " << MODELS_DIRECTORY << std::endl;
     std::vector<std::string> modelExtensions = { ".obj", ".fbx", ".gltf", ".glb", ".dae", ".3ds", ".blend" };
@@ -78,7 +87,7 @@ void Application::init()
     }
 
     // Crear input manager (después de grid y simulator)
-    inputManager = std::make_unique<InputManager>(window->getHandle(), *camera, *grid, *simulator);
+    inputManager = std::make_unique<InputManager>(window->getHandle(), *camera, *simulation);
 
     // Configurar OpenGL
     glEnable(GL_DEPTH_TEST);
@@ -121,6 +130,8 @@ void Application::init()
     std::cout << "  Mouse Scroll: Zoom in/out" << std::endl;
     std::cout << "  WASD: Pan camera | Q/E: Up/Down" << std::endl;
     std::cout << "  ESC: Exit\n" << std::endl;
+
+    simulation->start();
 }
 
 void Application::run()
@@ -134,19 +145,23 @@ void Application::run()
     }
 
     std::cout << "Shutting down..." << std::endl;
+    simulation->stop();
 }
 
 void Application::update()
 {
     inputManager->processKeyboard(deltaTime);
-    simulator->update(deltaTime);
-    stats->update(*grid, deltaTime);
+
+    // La simulación avanza en su hilo: aquí solo se toma la última instantánea, sin esperar
+    simulation->acquireSnapshot();
+    const SimulationSnapshot& snapshot = simulation->getSnapshot();
+    stats->update(snapshot, deltaTime);
 
     // Mostrar stats cada segundo
     static float statsTimer = 0.0f;
     statsTimer += deltaTime;
     if (statsTimer >= 1.0f) {
-        std::cout << "\r" << Rules::getName(simulator->getRuleType()) << " | Gen: " << simulator->getGeneration()
+        std::cout << "\r" << Rules::getName(snapshot.rule) << " | Gen: " << snapshot.generation
                   << " | " << stats->toString() << "          " << std::flush;
         statsTimer = 0.0f;
     }
@@ -195,12 +210,27 @@ void Application::render()
     shader->unuse();
 
     // Renderizar UI (debe ser después de la escena 3D)
+    updateGridTexture();
     ui->newFrame();
-    ui->renderStatsPanel(*simulator, *stats, *grid);
+    const SimulationSnapshot& snapshot = simulation->getSnapshot();
+    ui->renderStatsPanel(*simulation, *stats);
+    ui->renderGridPanel(gridTexture, snapshot.width, snapshot.height);
     ui->renderVideoSettingsPanel(*window);
     ui->render();
 }
 
+void Application::updateGridTexture()
+{
+    // Con la simulación en pausa y sin ediciones no hay nada que volver a subir
+    const SimulationSnapshot& snapshot = simulation->getSnapshot();
+    if (snapshot.revision == gridTextureRevision)
+        return;
+
+    // La paleta ya se aplicó en el hilo de simulación (con Lenia, sobre el campo continuo)
+    Renderer::TextureLoader::updateDynamic(gridTexture, snapshot.pixels.data(), snapshot.width, snapshot.height);
+    gridTextureRevision = snapshot.revision;
+}
+
 void Application::calculateDeltaTime()
 {
     float currentFrame = glfwGetTime();
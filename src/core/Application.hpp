@@ -19,6 +19,7 @@
 #include "Grid2D.hpp"
 #include "Simulator.hpp"
 #include "Stats.hpp"
+#include "SimulationThread.hpp"
 #include <memory>
 
 namespace Core {
@@ -63,9 +64,14 @@ private:
     // Simulación
     std::unique_ptr<Grid2D> grid;
     std::unique_ptr<Simulator> simulator;
+    std::unique_ptr<SimulationThread> simulation;  // Único dueño del simulador mientras corre
     std::unique_ptr<Stats> stats;
     std::vector<std::unique_ptr<Renderer::Model>> loadedModels;
 
+    // Imagen del grid: la instantánea trae el buffer RGBA ya pintado -> textura
+    GLuint gridTexture;
+    uint64_t gridTextureRevision;  // Revisión del grid subida a la textura
+
     // Iluminación
     Renderer::LightManager lightManager;
     Renderer::Material material;
@@ -88,6 +94,11 @@ private:
      */
     void render();
 
+    /**
+     * @brief Sube la imagen de la última instantánea si cambió desde la última subida
+     */
+    void updateGridTexture();
+
     /**
      * @brief Calcula delta time
      */
@@ -0,0 +1,491 @@
+/**
+ * @file BitKernel.cpp
+ * @brief Implementación del kernel empaquetado en bits
+ */
+
+#include "BitKernel.hpp"
+#include "Rules.hpp"
+#include <algorithm>
+#include <bit>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIT_KERNEL_X86 1
+// Las implementaciones se insertan en la variante POPCNT y en la genérica
+#define BIT_KERNEL_INLINE __attribute__((always_inline)) inline
+#else
+#define BIT_KERNEL_INLINE inline
+#endif
+
+namespace Core {
+
+namespace {
+
+// Con las reglas predefinidas (StaticRule) las máscaras son constantes y applyRule
+// se reduce a unas pocas operaciones sin bucle
+template <typename R>
+BIT_KERNEL_INLINE StepCounts stepRowsImpl(const Grid2D& grid, uint64_t* out, int y0, int y1, int w0, int w1, R rule)
+{
+    const int wordsPerRow = grid.getWordsPerRow();
+    const uint64_t lastMask = grid.getLastWordMask();
+    StepCounts counts;
+
+    for (int y = y0; y < y1; ++y) {
+        // El halo (filas -1/height, palabras -1/wordsPerRow) ya tiene los vecinos del borde
+        const uint64_t* up = grid.getBitRow(y - 1);
+        const uint64_t* mid = grid.getBitRow(y);
+        const uint64_t* down = grid.getBitRow(y + 1);
+        uint64_t* dst = out + grid.getBitOffset(y);
+
+        // Ventana deslizante de tres palabras por fila
+        uint64_t upL = up[w0 - 1], upC = up[w0];
+        uint64_t midL = mid[w0 - 1], midC = mid[w0];
+        uint64_t downL = down[w0 - 1], downC = down[w0];
+
+        for (int w = w0; w < w1; ++w) {
+            uint64_t upR = up[w + 1];
+            uint64_t midR = mid[w + 1];
+            uint64_t downR = down[w + 1];
+
+            // Los bits de relleno (y la celda fantasma derecha) no son celdas
+            uint64_t mask = (w + 1 < wordsPerRow) ? ~0ULL : lastMask;
+            uint64_t next = BitKernel::stepWord(upL, upC, upR, midL, midC, midR, downL, downC, downR, rule.birthMask,
+                                                rule.survivalMask) &
+                            mask;
+            dst[w] = next;
+            counts.births += std::popcount(next & ~midC);
+            counts.deaths += std::popcount(midC & ~next & mask);
+
+            upL = upC;
+            upC = upR;
+            midL = midC;
+            midC = midR;
+            downL = downC;
+            downC = downR;
+        }
+    }
+
+    // Con dos estados toda celda que cambia nace o muere
+    counts.changed = counts.births + counts.deaths;
+    return counts;
+}
+
+template <typename R>
+uint64_t stepBlockImpl(const uint64_t* center, const uint64_t* const neighbors[8], uint64_t* out, R rule)
+{
+    const uint64_t* north = neighbors[0];
+    const uint64_t* south = neighbors[1];
+    const uint64_t* west = neighbors[2];
+    const uint64_t* east = neighbors[3];
+    uint64_t any = 0;
+
+    for (int r = 0; r < 64; ++r) {
+        // Fila superior/inferior: dentro del bloque o en los vecinos N/S (y sus esquinas)
+        uint64_t upL = r > 0 ? west[r - 1] : neighbors[4][63];
+        uint64_t up = r > 0 ? center[r - 1] : north[63];
+        uint64_t upR = r > 0 ? east[r - 1] : neighbors[5][63];
+        uint64_t downL = r < 63 ? west[r + 1] : neighbors[6][0];
+        uint64_t down = r < 63 ? center[r + 1] : south[0];
+        uint64_t downR = r < 63 ? east[r + 1] : neighbors[7][0];
+
+        uint64_t next = BitKernel::stepWord(upL, up, upR, west[r], center[r], east[r], downL, down, downR,
+                                            rule.birthMask, rule.survivalMask);
+        out[r] = next;
+        any |= next;
+    }
+
+    return any;
+}
+
+/**
+ * @brief Celdas vivas (estado 1) de una palabra con P planos
+ * @param row Plano 0 de la fila; el plano p está planeStride palabras más adelante
+ */
+template <int P>
+inline uint64_t aliveWord(const uint64_t* row, int w, int planeStride)
+{
+    uint64_t alive = row[w];
+    for (int p = 1; p < P; ++p)
+        alive &= ~row[static_cast<ptrdiff_t>(p) * planeStride + w];
+    return alive;
+}
+
+/**
+ * @brief Siguiente estado Generations de 64 celdas con P planos
+ *
+ * Los vecinos son las palabras vivas (estado 1); state son los planos de la
+ * palabra central. Las celdas que nacen o sobreviven pasan a 1 y el resto de
+ * las ocupadas avanza un estado (C-1 pasa a DEAD).
+ */
+template <int P>
+BIT_KERNEL_INLINE void stepGenerationsWord(uint64_t upL, uint64_t upC, uint64_t upR, uint64_t midL, uint64_t midC,
+                                           uint64_t midR, uint64_t downL, uint64_t downC, uint64_t downR,
+                                           const uint64_t* state, const uint64_t* statesBits, uint64_t mask,
+                                           uint16_t birthMask, uint16_t survivalMask, uint64_t* next,
+                                           StepCounts& counts)
+{
+    uint64_t b0, b1, b2, b3;
+    BitKernel::countNeighbors(upL, upC, upR, midL, midC, midR, downL, downC, downR, b0, b1, b2, b3);
+    uint64_t born = BitKernel::matchCount(b0, b1, b2, b3, birthMask);
+    uint64_t keep = midC & BitKernel::matchCount(b0, b1, b2, b3, survivalMask);
+
+    // Estado + 1 por planos (sumador con acarreo)
+    uint64_t inc[P];
+    uint64_t occupied = 0;
+    uint64_t carry = ~0ULL;
+    uint64_t wrap = ~0ULL;
+    for (int p = 0; p < P; ++p) {
+        occupied |= state[p];
+        inc[p] = state[p] ^ carry;
+        carry &= state[p];
+        wrap &= ~(inc[p] ^ statesBits[p]);
+    }
+    wrap &= ~(carry ^ statesBits[P]);
+
+    // Nacen o sobreviven -> 1; el resto de ocupadas avanza (C-1 -> DEAD)
+    uint64_t one = (~occupied & born) | keep;
+    uint64_t advance = occupied & ~keep & ~wrap;
+    uint64_t changed = 0;
+    for (int p = 0; p < P; ++p) {
+        next[p] = ((inc[p] & advance) | (p == 0 ? one : 0)) & mask;
+        changed |= next[p] ^ state[p];
+    }
+    one &= mask;
+    counts.births += std::popcount(one & ~midC);
+    counts.deaths += std::popcount(midC & ~one & mask);
+    counts.changed += std::popcount(changed & mask);
+}
+
+template <int P>
+BIT_KERNEL_INLINE StepCounts stepRowsGenerationsImpl(const Grid2D& grid, uint64_t* out, int y0, int y1, int w0, int w1,
+                                   uint16_t birthMask, uint16_t survivalMask)
+{
+    const int wordsPerRow = grid.getWordsPerRow();
+    const int planeStride = grid.getBitStride();
+    const uint64_t lastMask = grid.getLastWordMask();
+    const int states = grid.getStateCount();
+    StepCounts counts;
+
+    // Bits de C (con un bit extra: C == 2^P desborda al incrementar C-1)
+    uint64_t statesBits[P + 1];
+    for (int p = 0; p <= P; ++p)
+        statesBits[p] = ((states >> p) & 1) ? ~0ULL : 0;
+
+    for (int y = y0; y < y1; ++y) {
+        const uint64_t* up = grid.getBitRow(y - 1);
+        const uint64_t* mid = grid.getBitRow(y);
+        const uint64_t* down = grid.getBitRow(y + 1);
+        uint64_t* dst = out + grid.getBitOffset(y);
+
+        // Ventana deslizante sobre las celdas vivas (estado 1), como en stepRows
+        uint64_t upL = aliveWord<P>(up, w0 - 1, planeStride), upC = aliveWord<P>(up, w0, planeStride);
+        uint64_t midL = aliveWord<P>(mid, w0 - 1, planeStride), midC = aliveWord<P>(mid, w0, planeStride);
+        uint64_t downL = aliveWord<P>(down, w0 - 1, planeStride), downC = aliveWord<P>(down, w0, planeStride);
+
+        for (int w = w0; w < w1; ++w) {
+            uint64_t upR = aliveWord<P>(up, w + 1, planeStride);
+            uint64_t midR = aliveWord<P>(mid, w + 1, planeStride);
+            uint64_t downR = aliveWord<P>(down, w + 1, planeStride);
+
+            uint64_t state[P], next[P];
+            for (int p = 0; p < P; ++p)
+                state[p] = mid[static_cast<size_t>(p) * planeStride + w];
+            uint64_t mask = (w + 1 < wordsPerRow) ? ~0ULL : lastMask;
+            stepGenerationsWord<P>(upL, upC, upR, midL, midC, midR, downL, downC, downR, state, statesBits, mask,
+                                   birthMask, survivalMask, next, counts);
+            for (int p = 0; p < P; ++p)
+                dst[static_cast<size_t>(p) * planeStride + w] = next[p];
+
+            upL = upC;
+            upC = upR;
+            midL = midC;
+            midC = midR;
+            downL = downC;
+            downC = downR;
+        }
+    }
+
+    return counts;
+}
+
+/**
+ * @class TileWindow
+ * @brief Columnas de tiles tx-1, tx y tx+1 de un tile (layout TILED)
+ *
+ * La fila -1 de cada columna es la última del tile de arriba y la TILE_SIZE
+ * la primera del de abajo; en un tile parcial del borde, la fila de altura
+ * height es la fantasma y está dentro del propio tile.
+ */
+class TileWindow {
+public:
+    TileWindow(const Grid2D& grid, int tx, int ty)
+    {
+        for (int dx = 0; dx < 3; ++dx) {
+            for (int dy = 0; dy < 3; ++dy)
+                tiles[dx][dy] = grid.getTile(tx - 1 + dx, ty - 1 + dy);
+        }
+    }
+
+    // Palabra de la fila r (-1 a TILE_SIZE) de la columna dx (0 = oeste) en un plano
+    uint64_t at(int dx, int r, int plane = 0) const
+    {
+        const size_t base = static_cast<size_t>(plane) * Grid2D::TILE_SIZE;
+        if (r < 0)
+            return tiles[dx][0][base + Grid2D::TILE_SIZE - 1];
+        if (r >= Grid2D::TILE_SIZE)
+            return tiles[dx][2][base + r - Grid2D::TILE_SIZE];
+        return tiles[dx][1][base + r];
+    }
+
+    // Filas 0 a TILE_SIZE - 1 de la columna dx en un plano
+    const uint64_t* center(int dx, int plane = 0) const
+    {
+        return tiles[dx][1] + static_cast<size_t>(plane) * Grid2D::TILE_SIZE;
+    }
+
+    // Celdas vivas (estado 1) de la fila r de la columna dx con P planos
+    template <int P>
+    uint64_t alive(int dx, int r) const
+    {
+        uint64_t word = at(dx, r);
+        for (int p = 1; p < P; ++p)
+            word &= ~at(dx, r, p);
+        return word;
+    }
+
+private:
+    const uint64_t* tiles[3][3];
+};
+
+template <typename R>
+BIT_KERNEL_INLINE StepCounts stepTileImpl(const Grid2D& grid, uint64_t* out, int tx, int ty, R rule)
+{
+    const TileWindow window(grid, tx, ty);
+    const int rows = std::min(Grid2D::TILE_SIZE, grid.getHeight() - ty * Grid2D::TILE_SIZE);
+    const uint64_t mask = tx + 1 < grid.getTilesX() ? ~0ULL : grid.getLastWordMask();
+    uint64_t* dst = out + grid.getTileOffset(tx, ty);
+    StepCounts counts;
+
+    // Ventana deslizante de tres filas por columna, como en stepRows; solo la última fila de un
+    // tile completo lee del tile de abajo
+    const uint64_t* west = window.center(0);
+    const uint64_t* middle = window.center(1);
+    const uint64_t* east = window.center(2);
+    uint64_t upL = window.at(0, -1), upC = window.at(1, -1), upR = window.at(2, -1);
+    uint64_t midL = west[0], midC = middle[0], midR = east[0];
+    for (int r = 0; r < rows; ++r) {
+        uint64_t downL, downC, downR;
+        if (r + 1 < Grid2D::TILE_SIZE) {
+            downL = west[r + 1];
+            downC = middle[r + 1];
+            downR = east[r + 1];
+        } else {
+            downL = window.at(0, r + 1);
+            downC = window.at(1, r + 1);
+            downR = window.at(2, r + 1);
+        }
+        uint64_t next = BitKernel::stepWord(upL, upC, upR, midL, midC, midR, downL, downC, downR, rule.birthMask,
+                                            rule.survivalMask) &
+                        mask;
+        dst[r] = next;
+        counts.births += std::popcount(next & ~midC);
+        counts.deaths += std::popcount(midC & ~next & mask);
+
+        upL = midL;
+        upC = midC;
+        upR = midR;
+        midL = downL;
+        midC = downC;
+        midR = downR;
+    }
+
+    counts.changed = counts.births + counts.deaths;
+    return counts;
+}
+
+template <int P>
+BIT_KERNEL_INLINE StepCounts stepTileGenerationsImpl(const Grid2D& grid, uint64_t* out, int tx, int ty,
+                                                     uint16_t birthMask, uint16_t survivalMask)
+{
+    const TileWindow window(grid, tx, ty);
+    const int rows = std::min(Grid2D::TILE_SIZE, grid.getHeight() - ty * Grid2D::TILE_SIZE);
+    const uint64_t mask = tx + 1 < grid.getTilesX() ? ~0ULL : grid.getLastWordMask();
+    const int states = grid.getStateCount();
+    uint64_t* dst = out + grid.getTileOffset(tx, ty);
+    StepCounts counts;
+
+    uint64_t statesBits[P + 1];
+    for (int p = 0; p <= P; ++p)
+        statesBits[p] = ((states >> p) & 1) ? ~0ULL : 0;
+
+    uint64_t upL = window.alive<P>(0, -1), upC = window.alive<P>(1, -1), upR = window.alive<P>(2, -1);
+    uint64_t midL = window.alive<P>(0, 0), midC = window.alive<P>(1, 0), midR = window.alive<P>(2, 0);
+    for (int r = 0; r < rows; ++r) {
+        uint64_t downL = window.alive<P>(0, r + 1), downC = window.alive<P>(1, r + 1);
+        uint64_t downR = window.alive<P>(2, r + 1);
+
+        uint64_t state[P], next[P];
+        for (int p = 0; p < P; ++p)
+            state[p] = window.at(1, r, p);
+        stepGenerationsWord<P>(upL, upC, upR, midL, midC, midR, downL, downC, downR, state, statesBits, mask,
+                               birthMask, survivalMask, next, counts);
+        for (int p = 0; p < P; ++p)
+            dst[static_cast<size_t>(p) * Grid2D::TILE_SIZE + r] = next[p];
+
+        upL = midL;
+        upC = midC;
+        upR = midR;
+        midL = downL;
+        midC = downC;
+        midR = downR;
+    }
+
+    return counts;
+}
+
+#ifdef BIT_KERNEL_X86
+template <typename R>
+__attribute__((target("popcnt"))) StepCounts stepTilePopcnt(const Grid2D& grid, uint64_t* out, int tx, int ty,
+                                                            R rule)
+{
+    return stepTileImpl(grid, out, tx, ty, rule);
+}
+
+template <int P>
+__attribute__((target("popcnt"))) StepCounts stepTileGenerationsPopcnt(const Grid2D& grid, uint64_t* out, int tx,
+                                                                       int ty, uint16_t birthMask,
+                                                                       uint16_t survivalMask)
+{
+    return stepTileGenerationsImpl<P>(grid, out, tx, ty, birthMask, survivalMask);
+}
+
+template <typename R>
+__attribute__((target("popcnt"))) StepCounts stepRowsPopcnt(const Grid2D& grid, uint64_t* out, int y0, int y1,
+                                                            int w0, int w1, R rule)
+{
+    return stepRowsImpl(grid, out, y0, y1, w0, w1, rule);
+}
+
+template <int P>
+__attribute__((target("popcnt"))) StepCounts stepRowsGenerationsPopcnt(const Grid2D& grid, uint64_t* out, int y0,
+                                                                       int y1, int w0, int w1, uint16_t birthMask,
+                                                                       uint16_t survivalMask)
+{
+    return stepRowsGenerationsImpl<P>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+}
+#endif
+
+template <int P>
+StepCounts stepRowsGenerationsAny(const Grid2D& grid, uint64_t* out, int y0, int y1, int w0, int w1,
+                                  uint16_t birthMask, uint16_t survivalMask)
+{
+#ifdef BIT_KERNEL_X86
+    if (BitKernel::hasPopcount())
+        return stepRowsGenerationsPopcnt<P>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+#endif
+    return stepRowsGenerationsImpl<P>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+}
+
+template <int P>
+StepCounts stepTileGenerationsAny(const Grid2D& grid, uint64_t* out, int tx, int ty, uint16_t birthMask,
+                                  uint16_t survivalMask)
+{
+#ifdef BIT_KERNEL_X86
+    if (BitKernel::hasPopcount())
+        return stepTileGenerationsPopcnt<P>(grid, out, tx, ty, birthMask, survivalMask);
+#endif
+    return stepTileGenerationsImpl<P>(grid, out, tx, ty, birthMask, survivalMask);
+}
+
+}  // namespace
+
+bool BitKernel::hasPopcount()
+{
+#ifdef BIT_KERNEL_X86
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt") != 0;
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+StepCounts BitKernel::stepRowsGenerations(const Grid2D& grid, uint64_t* out, int y0, int y1, int w0, int w1,
+                                          uint16_t birthMask, uint16_t survivalMask)
+{
+    switch (grid.getPlaneCount()) {
+    case 1:
+        return stepRowsGenerationsAny<1>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    case 2:
+        return stepRowsGenerationsAny<2>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    case 3:
+        return stepRowsGenerationsAny<3>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    case 4:
+        return stepRowsGenerationsAny<4>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    case 5:
+        return stepRowsGenerationsAny<5>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    case 6:
+        return stepRowsGenerationsAny<6>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    case 7:
+        return stepRowsGenerationsAny<7>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    default:
+        return stepRowsGenerationsAny<8>(grid, out, y0, y1, w0, w1, birthMask, survivalMask);
+    }
+}
+
+StepCounts BitKernel::stepRows(const Grid2D& grid, uint64_t* out, int y0, int y1, int w0, int w1,
+                               uint16_t birthMask, uint16_t survivalMask)
+{
+    return Rules::visit(birthMask, survivalMask, [&](auto rule) {
+#ifdef BIT_KERNEL_X86
+        if (hasPopcount())
+            return stepRowsPopcnt(grid, out, y0, y1, w0, w1, rule);
+#endif
+        return stepRowsImpl(grid, out, y0, y1, w0, w1, rule);
+    });
+}
+
+StepCounts BitKernel::stepTile(const Grid2D& grid, uint64_t* out, int tx, int ty, uint16_t birthMask,
+                               uint16_t survivalMask)
+{
+    return Rules::visit(birthMask, survivalMask, [&](auto rule) {
+#ifdef BIT_KERNEL_X86
+        if (hasPopcount())
+            return stepTilePopcnt(grid, out, tx, ty, rule);
+#endif
+        return stepTileImpl(grid, out, tx, ty, rule);
+    });
+}
+
+StepCounts BitKernel::stepTileGenerations(const Grid2D& grid, uint64_t* out, int tx, int ty, uint16_t birthMask,
+                                          uint16_t survivalMask)
+{
+    switch (grid.getPlaneCount()) {
+    case 1:
+        return stepTileGenerationsAny<1>(grid, out, tx, ty, birthMask, survivalMask);
+    case 2:
+        return stepTileGenerationsAny<2>(grid, out, tx, ty, birthMask, survivalMask);
+    case 3:
+        return stepTileGenerationsAny<3>(grid, out, tx, ty, birthMask, survivalMask);
+    case 4:
+        return stepTileGenerationsAny<4>(grid, out, tx, ty, birthMask, survivalMask);
+    case 5:
+        return stepTileGenerationsAny<5>(grid, out, tx, ty, birthMask, survivalMask);
+    case 6:
+        return stepTileGenerationsAny<6>(grid, out, tx, ty, birthMask, survivalMask);
+    case 7:
+        return stepTileGenerationsAny<7>(grid, out, tx, ty, birthMask, survivalMask);
+    default:
+        return stepTileGenerationsAny<8>(grid, out, tx, ty, birthMask, survivalMask);
+    }
+}
+
+uint64_t BitKernel::stepBlock(const uint64_t* center, const uint64_t* const neighbors[8], uint64_t* out,
+                              uint16_t birthMask, uint16_t survivalMask)
+{
+    return Rules::visit(birthMask, survivalMask,
+                        [&](auto rule) { return stepBlockImpl(center, neighbors, out, rule); });
+}
+
+}  // namespace Core
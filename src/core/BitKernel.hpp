@@ -0,0 +1,244 @@
+/**
+ * @file BitKernel.hpp
+ * @brief Kernel de paso para grillas empaquetadas en bits
+ *
+ * Calcula 64 celdas a la vez: los 8 vecinos de cada celda se suman con
+ * sumadores bit-slice (cada bit de la palabra es un carril independiente).
+ * Las reglas Generations usan un plano de bits por bit del estado.
+ */
+
+#ifndef BIT_KERNEL_HPP
+#define BIT_KERNEL_HPP
+
+#include "Grid2D.hpp"
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * @class BitKernel
+ * @brief Paso de autómatas totalísticos sobre los layouts GridLayout::BITS y TILED
+ */
+class BitKernel {
+public:
+    /**
+     * @brief Calcula el rectángulo [w0, w1) x [y0, y1) de la siguiente generación
+     *
+     * Los vecinos del borde salen del halo del grid (ver Grid2D::refreshHalo).
+     *
+     * @param grid Grid de origen (layout BITS)
+     * @param out Buffer destino con la forma de grid.getBitData()
+     * @param y0 Primera fila
+     * @param y1 Fila final (exclusiva)
+     * @param w0 Primera palabra de cada fila
+     * @param w1 Palabra final (exclusiva)
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     * @return Nacimientos, muertes y celdas cambiadas en el rectángulo
+     */
+    static StepCounts stepRows(const Grid2D& grid, uint64_t* out, int y0, int y1, int w0, int w1,
+                               uint16_t birthMask, uint16_t survivalMask);
+
+    /**
+     * @brief Calcula el rectángulo [w0, w1) x [y0, y1) con una regla Generations
+     *
+     * Usa todos los planos del grid: el estado de cada celda se lee y se
+     * escribe en binario, un bit por plano.
+     *
+     * @param grid Grid de origen (layout BITS, grid.getStateCount() estados, halo actualizado)
+     * @param out Buffer destino con la forma de grid.getBitData()
+     * @param y0 Primera fila
+     * @param y1 Fila final (exclusiva)
+     * @param w0 Primera palabra de cada fila
+     * @param w1 Palabra final (exclusiva)
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     * @return Nacimientos, muertes y celdas cambiadas en el rectángulo
+     */
+    static StepCounts stepRowsGenerations(const Grid2D& grid, uint64_t* out, int y0, int y1, int w0, int w1,
+                                          uint16_t birthMask, uint16_t survivalMask);
+
+    /**
+     * @brief Calcula un tile de la siguiente generación (layout TILED)
+     *
+     * Los vecinos salen de los 8 tiles de alrededor (y del anillo de halo en
+     * el borde, ver Grid2D::refreshHalo).
+     *
+     * @param grid Grid de origen (layout TILED, halo actualizado)
+     * @param out Buffer destino con la forma de grid.getBitData()
+     * @param tx Columna de tiles
+     * @param ty Fila de tiles
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     * @return Nacimientos, muertes y celdas cambiadas en el tile
+     */
+    static StepCounts stepTile(const Grid2D& grid, uint64_t* out, int tx, int ty, uint16_t birthMask,
+                               uint16_t survivalMask);
+
+    /**
+     * @brief Calcula un tile de la siguiente generación con una regla Generations (layout TILED)
+     * @param grid Grid de origen (layout TILED, grid.getStateCount() estados, halo actualizado)
+     * @param out Buffer destino con la forma de grid.getBitData()
+     * @param tx Columna de tiles
+     * @param ty Fila de tiles
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     * @return Nacimientos, muertes y celdas cambiadas en el tile
+     */
+    static StepCounts stepTileGenerations(const Grid2D& grid, uint64_t* out, int tx, int ty, uint16_t birthMask,
+                                          uint16_t survivalMask);
+
+    /**
+     * @brief Calcula la siguiente generación de un bloque de 64x64 celdas
+     *
+     * Cada bloque son 64 filas de una palabra. Los vecinos ausentes deben
+     * apuntar a un bloque vacío.
+     *
+     * @param center Bloque a calcular
+     * @param neighbors Vecinos en orden N, S, W, E, NW, NE, SW, SE
+     * @param out Bloque destino (64 palabras)
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     * @return OR de todas las filas resultantes (0 si el bloque quedó vacío)
+     */
+    static uint64_t stepBlock(const uint64_t* center, const uint64_t* const neighbors[8], uint64_t* out,
+                              uint16_t birthMask, uint16_t survivalMask);
+
+    /**
+     * @brief Verifica si la CPU tiene POPCNT
+     *
+     * Sin -mpopcnt std::popcount es una llamada a libgcc; los kernels que
+     * cuentan celdas por palabra tienen una variante compilada con POPCNT
+     * que se elige con esta comprobación.
+     *
+     * @return true en x86 con POPCNT
+     */
+    static bool hasPopcount();
+
+    /**
+     * @brief Calcula la siguiente generación de 64 celdas
+     *
+     * Cada parámetro es una palabra de 64 celdas consecutivas; los sufijos
+     * L/R son las palabras vecinas a izquierda/derecha (solo se usa el bit
+     * del borde) y up/mid/down las filas superior, actual e inferior.
+     */
+    static inline uint64_t stepWord(uint64_t upL, uint64_t up, uint64_t upR, uint64_t midL, uint64_t mid,
+                                    uint64_t midR, uint64_t downL, uint64_t down, uint64_t downR, uint16_t birthMask,
+                                    uint16_t survivalMask)
+    {
+        uint64_t b0, b1, b2, b3;
+        countNeighbors(upL, up, upR, midL, mid, midR, downL, down, downR, b0, b1, b2, b3);
+        return applyRule(mid, b0, b1, b2, b3, birthMask, survivalMask);
+    }
+
+    /**
+     * @brief Suma bit-slice de los 8 vecinos de 64 celdas
+     *
+     * El conteo de cada carril queda en b0 + 2*b1 + 4*b2 + 8*b3.
+     */
+    static inline void countNeighbors(uint64_t upL, uint64_t up, uint64_t upR, uint64_t midL, uint64_t mid,
+                                      uint64_t midR, uint64_t downL, uint64_t down, uint64_t downR, uint64_t& b0,
+                                      uint64_t& b1, uint64_t& b2, uint64_t& b3)
+    {
+        // Vecinos desplazados: bit i recibe la celda x-1 (west) o x+1 (east)
+        uint64_t uw = (up << 1) | (upL >> 63);
+        uint64_t ue = (up >> 1) | (upR << 63);
+        uint64_t mw = (mid << 1) | (midL >> 63);
+        uint64_t me = (mid >> 1) | (midR << 63);
+        uint64_t dw = (down << 1) | (downL >> 63);
+        uint64_t de = (down >> 1) | (downR << 63);
+
+        // Suma por fila (peso 1 y peso 2)
+        uint64_t uSum, uCarry, dSum, dCarry;
+        fullAdd(uw, up, ue, uSum, uCarry);
+        fullAdd(dw, down, de, dSum, dCarry);
+        uint64_t mSum = mw ^ me;
+        uint64_t mCarry = mw & me;
+
+        // Bits de peso 1
+        uint64_t onesCarry;
+        fullAdd(uSum, dSum, mSum, b0, onesCarry);
+
+        // Bits de peso 2 (cuatro entradas)
+        uint64_t twos, fours;
+        fullAdd(uCarry, dCarry, mCarry, twos, fours);
+        b1 = twos ^ onesCarry;
+        uint64_t fours2 = twos & onesCarry;
+
+        // Bits de peso 4 y 8
+        b2 = fours ^ fours2;
+        b3 = fours & fours2;
+    }
+
+    /**
+     * @brief Suma bit-slice de 8 palabras de vecinos ya alineadas (sin desplazamientos)
+     *
+     * Para layouts en los que cada carril es un universo distinto (ver
+     * Ensemble): el vecino de cada carril está en el mismo bit de otra palabra.
+     *
+     * @param neighbors Las 8 palabras vecinas
+     * @param b0 Bit 0 del conteo
+     * @param b1 Bit 1 del conteo
+     * @param b2 Bit 2 del conteo
+     * @param b3 Bit 3 del conteo
+     */
+    static inline void countLanes(const uint64_t neighbors[8], uint64_t& b0, uint64_t& b1, uint64_t& b2, uint64_t& b3)
+    {
+        uint64_t sumA, carryA, sumB, carryB;
+        fullAdd(neighbors[0], neighbors[1], neighbors[2], sumA, carryA);
+        fullAdd(neighbors[3], neighbors[4], neighbors[5], sumB, carryB);
+        uint64_t sumC = neighbors[6] ^ neighbors[7];
+        uint64_t carryC = neighbors[6] & neighbors[7];
+
+        // Mismo árbol que countNeighbors: peso 1, luego los cuatro acarreos de peso 2
+        uint64_t onesCarry;
+        fullAdd(sumA, sumB, sumC, b0, onesCarry);
+        uint64_t twos, fours;
+        fullAdd(carryA, carryB, carryC, twos, fours);
+        b1 = twos ^ onesCarry;
+        uint64_t fours2 = twos & onesCarry;
+        b2 = fours ^ fours2;
+        b3 = fours & fours2;
+    }
+
+    /**
+     * @brief Aplica una regla B/S a 64 celdas a partir del conteo bit-slice
+     * @param alive Celdas vivas actuales
+     * @return Celdas vivas en la siguiente generación
+     */
+    static inline uint64_t applyRule(uint64_t alive, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3,
+                                     uint16_t birthMask, uint16_t survivalMask)
+    {
+        uint64_t born = matchCount(b0, b1, b2, b3, birthMask);
+        uint64_t keep = matchCount(b0, b1, b2, b3, survivalMask);
+        return (alive & keep) | (~alive & born);
+    }
+
+    /**
+     * @brief Carriles cuyo conteo bit-slice está en una máscara
+     * @param mask Bit n activo para aceptar n vecinos
+     * @return Bit activo en los carriles aceptados
+     */
+    static inline uint64_t matchCount(uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3, uint16_t mask)
+    {
+        uint64_t match = 0;
+        for (int n = 0; n <= 8; ++n) {
+            if ((mask & (1u << n)) == 0)
+                continue;
+            match |= ((n & 1) ? b0 : ~b0) & ((n & 2) ? b1 : ~b1) & ((n & 4) ? b2 : ~b2) & ((n & 8) ? b3 : ~b3);
+        }
+        return match;
+    }
+
+private:
+    static inline void fullAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t& sum, uint64_t& carry)
+    {
+        uint64_t ab = a ^ b;
+        sum = ab ^ c;
+        carry = (a & b) | (ab & c);
+    }
+};
+
+}  // namespace Core
+
+#endif  // BIT_KERNEL_HPP
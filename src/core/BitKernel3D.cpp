@@ -0,0 +1,270 @@
+/**
+ * @file BitKernel3D.cpp
+ * @brief Implementación del kernel 3D empaquetado en bits
+ */
+
+#include "BitKernel3D.hpp"
+#include "BitKernel.hpp"
+#include <bit>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIT_KERNEL_3D_X86 1
+#define BIT_KERNEL_3D_INLINE __attribute__((always_inline)) inline
+#else
+#define BIT_KERNEL_3D_INLINE inline
+#endif
+
+namespace Core {
+
+namespace {
+
+inline void fullAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t& sum, uint64_t& carry)
+{
+    uint64_t ab = a ^ b;
+    sum = ab ^ c;
+    carry = (a & b) | (ab & c);
+}
+
+/**
+ * @brief Celdas vivas (estado 1) de una palabra con P planos
+ * @param row Plano 0 de la fila; el plano p está planeStride palabras más adelante
+ */
+template <int P>
+inline uint64_t aliveWord(const uint64_t* row, int w, int planeStride)
+{
+    uint64_t alive = row[w];
+    for (int p = 1; p < P; ++p)
+        alive &= ~row[static_cast<ptrdiff_t>(p) * planeStride + w];
+    return alive;
+}
+
+/**
+ * @brief Carriles cuyo conteo de 5 bits está en una máscara
+ *
+ * Con más de la mitad de los valores aceptados se evalúa el complemento.
+ */
+inline uint64_t matchCount(const uint64_t count[5], uint32_t mask)
+{
+    const uint32_t all = (1u << 28) - 1;
+    bool invert = std::popcount(mask & all) > 14;
+    uint32_t values = invert ? ~mask & all : mask & all;
+    uint64_t match = 0;
+    while (values != 0) {
+        int n = std::countr_zero(values);
+        values &= values - 1;
+        uint64_t eq = ~0ULL;
+        for (int b = 0; b < 5; ++b)
+            eq &= ((n >> b) & 1) ? count[b] : ~count[b];
+        match |= eq;
+    }
+    return invert ? ~match : match;
+}
+
+/**
+ * @brief Suma de 4 bits de las 9 filas vecinas (incluida la propia) en la palabra w
+ */
+template <int P>
+inline void columnSum(const uint64_t* const rows[9], int w, int planeStride, uint64_t sum[4])
+{
+    uint64_t s1, c1, s2, c2, s3, c3, c4;
+    fullAdd(aliveWord<P>(rows[0], w, planeStride), aliveWord<P>(rows[1], w, planeStride),
+            aliveWord<P>(rows[2], w, planeStride), s1, c1);
+    fullAdd(aliveWord<P>(rows[3], w, planeStride), aliveWord<P>(rows[4], w, planeStride),
+            aliveWord<P>(rows[5], w, planeStride), s2, c2);
+    fullAdd(aliveWord<P>(rows[6], w, planeStride), aliveWord<P>(rows[7], w, planeStride),
+            aliveWord<P>(rows[8], w, planeStride), s3, c3);
+    fullAdd(s1, s2, s3, sum[0], c4);
+
+    // Cuatro acarreos de peso 2
+    uint64_t t, u;
+    fullAdd(c1, c2, c3, t, u);
+    sum[1] = t ^ c4;
+    uint64_t k = t & c4;
+    sum[2] = u ^ k;
+    sum[3] = u & k;
+}
+
+/**
+ * @brief Vivas en el cubo 3x3x3 (Moore, hasta 27) o en la cruz de 7 celdas (von Neumann), incluida la central
+ */
+template <int P, bool Moore>
+BIT_KERNEL_3D_INLINE StepCounts stepSlicesImpl(const Grid3D& grid, uint64_t* out, int z0, int z1, const Rule3D& rule)
+{
+    StepCounts counts;
+    const int height = grid.getHeight();
+    const int wordsPerRow = grid.getWordsPerRow();
+    const int planeStride = grid.getBitStride();
+    const uint64_t lastMask = grid.getLastWordMask();
+    const int states = grid.getStateCount();
+
+    // El conteo incluye la celda: una viva con n vecinos cuenta n + 1
+    const uint32_t birthMask = rule.birthMask;
+    const uint32_t survivalMask = rule.survivalMask << 1;
+
+    // Bits de C (con un bit extra: C == 2^P desborda al incrementar C-1)
+    uint64_t statesBits[P + 1];
+    for (int p = 0; p <= P; ++p)
+        statesBits[p] = ((states >> p) & 1) ? ~0ULL : 0;
+
+    for (int z = z0; z < z1; ++z) {
+        for (int y = 0; y < height; ++y) {
+            // rows[(dz + 1) * 3 + (dy + 1)]
+            const uint64_t* rows[9];
+            for (int dz = -1; dz <= 1; ++dz) {
+                for (int dy = -1; dy <= 1; ++dy)
+                    rows[(dz + 1) * 3 + (dy + 1)] = grid.getBitRow(y + dy, z + dz);
+            }
+            const uint64_t* mid = rows[4];
+            uint64_t* dst = out + grid.getBitOffset(y, z);
+
+            // Ventana deslizante: columnas (Moore) o fila central (von Neumann) en w-1, w, w+1
+            uint64_t colL[4], colC[4], colR[4];
+            uint64_t midL = 0, midC = 0, midR = 0;
+            if constexpr (Moore) {
+                columnSum<P>(rows, -1, planeStride, colL);
+                columnSum<P>(rows, 0, planeStride, colC);
+            } else {
+                midL = aliveWord<P>(mid, -1, planeStride);
+                midC = aliveWord<P>(mid, 0, planeStride);
+            }
+
+            for (int w = 0; w < wordsPerRow; ++w) {
+                uint64_t count[5];
+                uint64_t alive;
+                if constexpr (Moore) {
+                    alive = aliveWord<P>(mid, w, planeStride);
+                    columnSum<P>(rows, w + 1, planeStride, colR);
+
+                    // Columnas desplazadas: la celda x recibe las de x-1 y x+1
+                    uint64_t s[4], k[4];
+                    for (int i = 0; i < 4; ++i) {
+                        uint64_t west = (colC[i] << 1) | (colL[i] >> 63);
+                        uint64_t east = (colC[i] >> 1) | (colR[i] << 63);
+                        fullAdd(west, colC[i], east, s[i], k[i]);
+                    }
+
+                    // s + 2k (hasta 27, cabe en 5 bits)
+                    uint64_t carry;
+                    count[0] = s[0];
+                    count[1] = s[1] ^ k[0];
+                    carry = s[1] & k[0];
+                    fullAdd(s[2], k[1], carry, count[2], carry);
+                    fullAdd(s[3], k[2], carry, count[3], carry);
+                    count[4] = k[3] ^ carry;
+
+                    for (int i = 0; i < 4; ++i) {
+                        colL[i] = colC[i];
+                        colC[i] = colR[i];
+                    }
+                } else {
+                    alive = midC;
+                    midR = aliveWord<P>(mid, w + 1, planeStride);
+                    uint64_t west = (midC << 1) | (midL >> 63);
+                    uint64_t east = (midC >> 1) | (midR << 63);
+
+                    // Siete entradas: fila central (3), arriba/abajo y delante/detrás
+                    uint64_t s1, c1, s2, c2, c3, t;
+                    fullAdd(west, midC, east, s1, c1);
+                    fullAdd(aliveWord<P>(rows[3], w, planeStride), aliveWord<P>(rows[5], w, planeStride),
+                            aliveWord<P>(rows[1], w, planeStride), s2, c2);
+                    fullAdd(s1, s2, aliveWord<P>(rows[7], w, planeStride), count[0], c3);
+                    fullAdd(c1, c2, c3, count[1], t);
+                    count[2] = t;
+                    count[3] = 0;
+                    count[4] = 0;
+                }
+
+                uint64_t born = matchCount(count, birthMask);
+                uint64_t keep = alive & matchCount(count, survivalMask);
+
+                // Estado actual por planos y estado + 1 (sumador con acarreo)
+                uint64_t state[P], inc[P];
+                uint64_t occupied = 0;
+                uint64_t carry = ~0ULL;
+                uint64_t wrap = ~0ULL;
+                for (int p = 0; p < P; ++p) {
+                    state[p] = mid[static_cast<size_t>(p) * planeStride + w];
+                    occupied |= state[p];
+                    inc[p] = state[p] ^ carry;
+                    carry &= state[p];
+                    wrap &= ~(inc[p] ^ statesBits[p]);
+                }
+                wrap &= ~(carry ^ statesBits[P]);
+
+                // Nacen o sobreviven -> 1; el resto de ocupadas avanza (C-1 -> DEAD)
+                uint64_t one = (~occupied & born) | keep;
+                uint64_t advance = occupied & ~keep & ~wrap;
+                uint64_t mask = (w + 1 < wordsPerRow) ? ~0ULL : lastMask;
+                uint64_t changed = 0;
+                for (int p = 0; p < P; ++p) {
+                    uint64_t next = ((inc[p] & advance) | (p == 0 ? one : 0)) & mask;
+                    dst[static_cast<size_t>(p) * planeStride + w] = next;
+                    changed |= next ^ state[p];
+                }
+                one &= mask;
+                counts.births += std::popcount(one & ~alive);
+                counts.deaths += std::popcount(alive & ~one & mask);
+                counts.changed += std::popcount(changed & mask);
+
+                if constexpr (!Moore) {
+                    midL = midC;
+                    midC = midR;
+                }
+            }
+        }
+    }
+    return counts;
+}
+
+#ifdef BIT_KERNEL_3D_X86
+template <int P, bool Moore>
+__attribute__((target("popcnt"))) StepCounts stepSlicesPopcnt(const Grid3D& grid, uint64_t* out, int z0, int z1,
+                                                              const Rule3D& rule)
+{
+    return stepSlicesImpl<P, Moore>(grid, out, z0, z1, rule);
+}
+#endif
+
+template <int P, bool Moore>
+StepCounts stepSlicesAny(const Grid3D& grid, uint64_t* out, int z0, int z1, const Rule3D& rule)
+{
+#ifdef BIT_KERNEL_3D_X86
+    if (BitKernel::hasPopcount())
+        return stepSlicesPopcnt<P, Moore>(grid, out, z0, z1, rule);
+#endif
+    return stepSlicesImpl<P, Moore>(grid, out, z0, z1, rule);
+}
+
+template <bool Moore>
+StepCounts stepSlicesPlanes(const Grid3D& grid, uint64_t* out, int z0, int z1, const Rule3D& rule)
+{
+    switch (grid.getPlaneCount()) {
+    case 1:
+        return stepSlicesAny<1, Moore>(grid, out, z0, z1, rule);
+    case 2:
+        return stepSlicesAny<2, Moore>(grid, out, z0, z1, rule);
+    case 3:
+        return stepSlicesAny<3, Moore>(grid, out, z0, z1, rule);
+    case 4:
+        return stepSlicesAny<4, Moore>(grid, out, z0, z1, rule);
+    case 5:
+        return stepSlicesAny<5, Moore>(grid, out, z0, z1, rule);
+    case 6:
+        return stepSlicesAny<6, Moore>(grid, out, z0, z1, rule);
+    case 7:
+        return stepSlicesAny<7, Moore>(grid, out, z0, z1, rule);
+    default:
+        return stepSlicesAny<8, Moore>(grid, out, z0, z1, rule);
+    }
+}
+
+}  // namespace
+
+StepCounts BitKernel3D::stepSlices(const Grid3D& grid, uint64_t* out, int z0, int z1, const Rule3D& rule)
+{
+    if (rule.neighborhood == Neighborhood::MOORE)
+        return stepSlicesPlanes<true>(grid, out, z0, z1, rule);
+    return stepSlicesPlanes<false>(grid, out, z0, z1, rule);
+}
+
+}  // namespace Core
@@ -0,0 +1,352 @@
+/**
+ * @file CellPalette.cpp
+ * @brief Implementación de la paleta de celdas
+ */
+
+#include "CellPalette.hpp"
+#include "BitKernel.hpp"
+#include "SimdKernel.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CELL_PALETTE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Core {
+
+namespace {
+
+// Expande los 8 bits de un byte a los 8 bytes de una palabra (bit i -> byte i)
+const std::array<uint64_t, 256> SPREAD = [] {
+    std::array<uint64_t, 256> table {};
+    for (int i = 0; i < 256; ++i) {
+        for (int bit = 0; bit < 8; ++bit)
+            table[i] |= static_cast<uint64_t>((i >> bit) & 1) << (8 * bit);
+    }
+    return table;
+}();
+
+constexpr uint64_t BYTE_ONES = 0x0101010101010101ULL;
+
+void mapScalar(const uint8_t* indices, uint8_t* out, int begin, int count, const uint8_t (*channels)[32])
+{
+    for (int x = begin; x < count; ++x) {
+        uint8_t index = indices[x];
+        out[4 * x + 0] = channels[0][index];
+        out[4 * x + 1] = channels[1][index];
+        out[4 * x + 2] = channels[2][index];
+        out[4 * x + 3] = channels[3][index];
+    }
+}
+
+#ifdef CELL_PALETTE_X86
+
+/**
+ * @brief 32 índices por iteración: un vpshufb por canal y entrelazado a RGBA
+ *
+ * Los unpack trabajan por carril de 128 bits, así que los píxeles 0-15 y
+ * 16-31 quedan repartidos entre carriles y se reordenan con vperm2i128.
+ */
+__attribute__((target("avx2"))) void mapAvx2(const uint8_t* indices, uint8_t* out, int count,
+                                             const uint8_t (*channels)[32])
+{
+    const __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(channels[0]));
+    const __m256i g = _mm256_load_si256(reinterpret_cast<const __m256i*>(channels[1]));
+    const __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(channels[2]));
+    const __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(channels[3]));
+
+    int x = 0;
+    for (; x + 32 <= count; x += 32) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + x));
+        __m256i red = _mm256_shuffle_epi8(r, index);
+        __m256i green = _mm256_shuffle_epi8(g, index);
+        __m256i blue = _mm256_shuffle_epi8(b, index);
+        __m256i alpha = _mm256_shuffle_epi8(a, index);
+
+        __m256i rgLow = _mm256_unpacklo_epi8(red, green);    // Píxeles 0-7 | 16-23
+        __m256i rgHigh = _mm256_unpackhi_epi8(red, green);   // Píxeles 8-15 | 24-31
+        __m256i baLow = _mm256_unpacklo_epi8(blue, alpha);
+        __m256i baHigh = _mm256_unpackhi_epi8(blue, alpha);
+        __m256i p0 = _mm256_unpacklo_epi16(rgLow, baLow);    // 0-3 | 16-19
+        __m256i p1 = _mm256_unpackhi_epi16(rgLow, baLow);    // 4-7 | 20-23
+        __m256i p2 = _mm256_unpacklo_epi16(rgHigh, baHigh);  // 8-11 | 24-27
+        __m256i p3 = _mm256_unpackhi_epi16(rgHigh, baHigh);  // 12-15 | 28-31
+
+        __m256i* dst = reinterpret_cast<__m256i*>(out + 4 * x);
+        _mm256_storeu_si256(dst + 0, _mm256_permute2x128_si256(p0, p1, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(p2, p3, 0x20));
+        _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(p0, p1, 0x31));
+        _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+    }
+    mapScalar(indices, out, x, count, channels);
+}
+
+#endif  // CELL_PALETTE_X86
+
+}  // namespace
+
+CellPalette::CellPalette() : stateCount(0)
+{
+    // Índices 0..8: vivas por número de vecinos; el resto, color de las muertas
+    uint8_t color[4];
+    for (int index = 0; index < 16; ++index) {
+        getColor(index <= 8 ? CellState::ALIVE : CellState::DEAD, index, 2, color);
+        for (int c = 0; c < 4; ++c) {
+            channels[c][index] = color[c];
+            channels[c][index + 16] = color[c];
+        }
+    }
+    buildStateColors(2);
+
+    // Rampa del campo: nivel 0 muerto; niveles 1..15 interpolan los colores de 0..8 vecinos
+    for (int level = 0; level < 16; ++level) {
+        uint8_t low[4], high[4];
+        float position = level / 15.0f * 8.0f;
+        int lower = std::min(static_cast<int>(position), 7);
+        float t = position - lower;
+        getColor(CellState::ALIVE, lower, 2, low);
+        getColor(CellState::ALIVE, lower + 1, 2, high);
+        if (level == 0)
+            getColor(CellState::DEAD, 0, 2, low);
+        for (int c = 0; c < 4; ++c) {
+            float value = level == 0 ? low[c] : low[c] + (high[c] - low[c]) * t;
+            fieldChannels[c][level] = static_cast<uint8_t>(std::lround(value));
+            fieldChannels[c][level + 16] = fieldChannels[c][level];
+        }
+    }
+}
+
+void CellPalette::getColor(CellState state, int neighbors, int stateCount, uint8_t rgba[4])
+{
+    float r, g, b;
+    if (state == CellState::DEAD) {
+        // Células muertas muy oscuras
+        r = 0.1f;
+        g = 0.1f;
+        b = 0.15f;
+    } else if (state != CellState::ALIVE) {
+        // Estados refractarios: se apagan hacia el color de las muertas
+        float fade = 1.0f - static_cast<float>(static_cast<int>(state) - 1) / static_cast<float>(stateCount - 1);
+        r = 0.1f + 0.7f * fade;
+        g = 0.1f + 0.2f * fade;
+        b = 0.15f;
+    } else {
+        // Células vivas: color según número de vecinos
+        float intensity = 0.3f + (neighbors / 8.0f) * 0.7f;  // 0.3 a 1.0
+        if (neighbors <= 2) {
+            r = 0.0f;
+            g = neighbors / 2.0f * 0.5f;
+            b = intensity;
+        } else if (neighbors <= 4) {
+            r = 0.0f;
+            g = intensity;
+            b = (4.0f - neighbors) / 2.0f * intensity;
+        } else if (neighbors <= 6) {
+            r = (neighbors - 4.0f) / 2.0f * intensity;
+            g = intensity;
+            b = 0.0f;
+        } else {
+            r = intensity;
+            g = (8.0f - neighbors) / 2.0f * 0.5f;
+            b = 0.0f;
+        }
+    }
+
+    auto toByte = [](float v) { return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+    rgba[0] = toByte(r);
+    rgba[1] = toByte(g);
+    rgba[2] = toByte(b);
+    rgba[3] = 255;
+}
+
+void CellPalette::buildStateColors(int states)
+{
+    stateCount = states;
+    stateColors.resize(static_cast<size_t>(states) * 4);
+    for (int s = 0; s < states; ++s)
+        getColor(static_cast<CellState>(s), 0, states, &stateColors[static_cast<size_t>(s) * 4]);
+}
+
+void CellPalette::buildBitIndices(const Grid2D& grid, int y)
+{
+    const int wordsPerRow = grid.getWordsPerRow();
+    const int planes = grid.getPlaneCount();
+
+    // Palabras vivas (estado 1) de las filas y-1, y, y+1, con sus palabras de halo. En el layout
+    // TILED las palabras de una fila están en tiles distintos y se copian
+    const uint64_t* rows[3];
+    if (planes == 1 && grid.getLayout() == GridLayout::BITS) {
+        for (int i = 0; i < 3; ++i)
+            rows[i] = grid.getBitRow(y - 1 + i);
+    } else {
+        aliveWords.resize(static_cast<size_t>(3) * (wordsPerRow + 2));
+        for (int i = 0; i < 3; ++i) {
+            uint64_t* alive = aliveWords.data() + static_cast<size_t>(i) * (wordsPerRow + 2) + 1;
+            for (int w = -1; w <= wordsPerRow; ++w) {
+                uint64_t word = grid.getBitWord(w, y - 1 + i);
+                for (int p = 1; p < planes; ++p)
+                    word &= ~grid.getBitWord(w, y - 1 + i, p);
+                alive[w] = word;
+            }
+            rows[i] = alive;
+        }
+    }
+
+    indices.resize(static_cast<size_t>(wordsPerRow) * 64);
+    const uint64_t* up = rows[0];
+    const uint64_t* mid = rows[1];
+    const uint64_t* down = rows[2];
+    for (int w = 0; w < wordsPerRow; ++w) {
+        uint64_t b0, b1, b2, b3;
+        BitKernel::countNeighbors(up[w - 1], up[w], up[w + 1], mid[w - 1], mid[w], mid[w + 1], down[w - 1], down[w],
+                                  down[w + 1], b0, b1, b2, b3);
+
+        // Cada byte de la palabra es el índice de una celda: conteo si vive, DEAD_INDEX si no
+        for (int k = 0; k < 8; ++k) {
+            const int shift = 8 * k;
+            uint64_t alive = SPREAD[(mid[w] >> shift) & 0xFF];
+            uint64_t count = SPREAD[(b0 >> shift) & 0xFF] | (SPREAD[(b1 >> shift) & 0xFF] << 1) |
+                             (SPREAD[(b2 >> shift) & 0xFF] << 2) | (SPREAD[(b3 >> shift) & 0xFF] << 3);
+            uint64_t index = (count & (alive * 0xFF)) | ((alive ^ BYTE_ONES) * DEAD_INDEX);
+            std::memcpy(indices.data() + static_cast<size_t>(w) * 64 + 8 * k, &index, sizeof(index));
+        }
+    }
+}
+
+void CellPalette::buildByteIndices(const Grid2D& grid, int y)
+{
+    const int width = grid.getWidth();
+    const uint8_t* up = reinterpret_cast<const uint8_t*>(grid.getByteRow(y - 1));
+    const uint8_t* mid = reinterpret_cast<const uint8_t*>(grid.getByteRow(y));
+    const uint8_t* down = reinterpret_cast<const uint8_t*>(grid.getByteRow(y + 1));
+    indices.resize(width);
+
+    int x = 0;
+#ifdef CELL_PALETTE_X86
+    // Solo el estado 1 cuenta como vecino: cada comparación suma -1 por carril
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i dead = _mm_set1_epi8(DEAD_INDEX);
+    auto isAlive = [&](const uint8_t* p) {
+        return _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), one);
+    };
+    for (; x + 16 <= width; x += 16) {
+        __m128i sum = _mm_add_epi8(_mm_add_epi8(isAlive(up + x - 1), isAlive(up + x)), isAlive(up + x + 1));
+        sum = _mm_add_epi8(sum, _mm_add_epi8(isAlive(mid + x - 1), isAlive(mid + x + 1)));
+        sum = _mm_add_epi8(sum, _mm_add_epi8(_mm_add_epi8(isAlive(down + x - 1), isAlive(down + x)),
+                                             isAlive(down + x + 1)));
+        __m128i count = _mm_sub_epi8(_mm_setzero_si128(), sum);
+        __m128i alive = isAlive(mid + x);
+        __m128i index = _mm_or_si128(_mm_and_si128(alive, count), _mm_andnot_si128(alive, dead));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices.data() + x), index);
+    }
+#endif
+    for (; x < width; ++x) {
+        int count = (up[x - 1] == 1) + (up[x] == 1) + (up[x + 1] == 1) + (mid[x - 1] == 1) + (mid[x + 1] == 1) +
+                    (down[x - 1] == 1) + (down[x] == 1) + (down[x + 1] == 1);
+        indices[x] = static_cast<uint8_t>(mid[x] == 1 ? count : DEAD_INDEX);
+    }
+}
+
+void CellPalette::buildFieldIndices(const float* values, int count)
+{
+    indices.resize(count);
+
+    // Nivel = redondeo de v * 15 con v recortado a [0, 1]
+    int x = 0;
+#ifdef CELL_PALETTE_X86
+    const __m128 scale = _mm_set1_ps(15.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    auto level = [&](const float* p) {
+        __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), zero), one);
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+    };
+    for (; x + 16 <= count; x += 16) {
+        __m128i low = _mm_packs_epi32(level(values + x), level(values + x + 4));
+        __m128i high = _mm_packs_epi32(level(values + x + 8), level(values + x + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices.data() + x), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; x < count; ++x) {
+        float v = std::clamp(values[x], 0.0f, 1.0f);
+        indices[x] = static_cast<uint8_t>(v * 15.0f + 0.5f);
+    }
+}
+
+void CellPalette::mapIndices(uint8_t* out, int count, const uint8_t (*table)[32]) const
+{
+#ifdef CELL_PALETTE_X86
+    if (SimdKernel::getIsa() >= SimdKernel::Isa::AVX2) {
+        mapAvx2(indices.data(), out, count, table);
+        return;
+    }
+#endif
+    mapScalar(indices.data(), out, 0, count, table);
+}
+
+void CellPalette::renderField(const std::vector<float>& field, int width, int height, std::vector<uint8_t>& rgba)
+{
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        buildFieldIndices(field.data() + static_cast<size_t>(y) * width, width);
+        mapIndices(rgba.data() + static_cast<size_t>(y) * width * 4, width, fieldChannels);
+    }
+}
+
+void CellPalette::render(Grid2D& grid, std::vector<uint8_t>& rgba)
+{
+    const int width = grid.getWidth();
+    const int height = grid.getHeight();
+    if (grid.getStateCount() != stateCount)
+        buildStateColors(grid.getStateCount());
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+    grid.refreshHalo();
+
+    const bool bits = grid.getLayout() != GridLayout::BYTES;
+    for (int y = 0; y < height; ++y) {
+        uint8_t* out = rgba.data() + static_cast<size_t>(y) * width * 4;
+        if (bits) {
+            buildBitIndices(grid, y);
+        } else {
+            buildByteIndices(grid, y);
+        }
+        mapIndices(out, width, channels);
+
+        if (stateCount <= 2)
+            continue;
+
+        // Estados refractarios: pocos por fila, se corrigen con su color tras la pasada vectorial
+        if (bits) {
+            const int planes = grid.getPlaneCount();
+            for (int w = 0; w < grid.getWordsPerRow(); ++w) {
+                uint64_t occupied = 0;
+                for (int p = 1; p < planes; ++p)
+                    occupied |= grid.getBitWord(w, y, p);
+                if (w == grid.getWordsPerRow() - 1)
+                    occupied &= grid.getLastWordMask();
+                for (; occupied != 0; occupied &= occupied - 1) {
+                    int bit = std::countr_zero(occupied);
+                    int state = 0;
+                    for (int p = 0; p < planes; ++p)
+                        state |= static_cast<int>((grid.getBitWord(w, y, p) >> bit) & 1) << p;
+                    std::memcpy(out + static_cast<size_t>(w * 64 + bit) * 4, &stateColors[state * 4], 4);
+                }
+            }
+        } else {
+            const CellState* row = grid.getByteRow(y);
+            for (int x = 0; x < width; ++x) {
+                int state = static_cast<int>(row[x]);
+                if (state >= 2)
+                    std::memcpy(out + static_cast<size_t>(x) * 4, &stateColors[state * 4], 4);
+            }
+        }
+    }
+}
+
+}  // namespace Core
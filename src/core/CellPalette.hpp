@@ -0,0 +1,120 @@
+/**
+ * @file CellPalette.hpp
+ * @brief Conversión del grid a un buffer RGBA8 listo para subir a una textura
+ *
+ * Cada celda se reduce a un índice de paleta de un byte (vecinos vivos 0..8
+ * para las vivas, DEAD_INDEX para las muertas) y una tabla de 16 entradas por
+ * canal lo convierte en RGBA con un shuffle por cada 32 celdas. Los índices
+ * salen del sumador bit-slice (layouts BITS y TILED) o de comparaciones SSE2 (layout
+ * BYTES), en lugar de contar vecinos y evaluar ramas por cada celda. Los
+ * campos continuos (Lenia) se cuantizan a 16 niveles y usan la misma pasada.
+ */
+
+#ifndef CELL_PALETTE_HPP
+#define CELL_PALETTE_HPP
+
+#include "Grid2D.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class CellPalette
+ * @brief Paleta (estado, vecinos) -> RGBA8 y su pasada sobre el grid
+ */
+class CellPalette {
+public:
+    // Índice de paleta de las celdas muertas (las vivas usan 0..8 vecinos)
+    static constexpr int DEAD_INDEX = 15;
+
+    /**
+     * @brief Constructor (paleta para reglas de dos estados)
+     */
+    CellPalette();
+
+    /**
+     * @brief Color de una celda
+     *
+     * Muertas en gris azulado oscuro; vivas de azul (pocos vecinos) a rojo
+     * (muchos); los estados refractarios se apagan hacia el color de las muertas.
+     *
+     * @param state Estado de la celda
+     * @param neighbors Vecinos vivos (solo se usa con ALIVE)
+     * @param stateCount Número de estados de la regla
+     * @param rgba Destino de los 4 bytes R, G, B, A
+     */
+    static void getColor(CellState state, int neighbors, int stateCount, uint8_t rgba[4]);
+
+    /**
+     * @brief Rellena un buffer RGBA8 con el contenido del grid
+     *
+     * Actualiza el halo del grid para que los vecinos del borde sigan el modo
+     * de borde. Las filas se escriben de y = 0 a y = height - 1.
+     *
+     * @param grid Grid a pintar
+     * @param rgba Destino (se redimensiona a width * height * 4 bytes)
+     */
+    void render(Grid2D& grid, std::vector<uint8_t>& rgba);
+
+    /**
+     * @brief Rellena un buffer RGBA8 con un campo continuo en [0, 1]
+     *
+     * El 0 usa el color de las muertas y los valores positivos recorren la
+     * rampa de las vivas (de azul a rojo) en 15 niveles.
+     *
+     * @param field width * height valores, fila a fila
+     * @param width Ancho del campo
+     * @param height Alto del campo
+     * @param rgba Destino (se redimensiona a width * height * 4 bytes)
+     */
+    void renderField(const std::vector<float>& field, int width, int height, std::vector<uint8_t>& rgba);
+
+private:
+    // Tablas por canal: las 16 entradas repetidas en cada carril de 128 bits (vpshufb)
+    alignas(32) uint8_t channels[4][32];
+    alignas(32) uint8_t fieldChannels[4][32];  // Rampa de 16 niveles para campos continuos
+    std::vector<uint8_t> stateColors;  // 4 bytes por estado (refractarios incluidos)
+    int stateCount;                    // Estados con los que se construyó stateColors
+    std::vector<uint8_t> indices;      // Índices de la fila en curso
+    std::vector<uint64_t> aliveWords;  // Palabras vivas de tres filas (reglas con varios planos)
+
+    /**
+     * @brief Reconstruye las tablas de color de los estados
+     * @param states Número de estados de la regla
+     */
+    void buildStateColors(int states);
+
+    /**
+     * @brief Índices de paleta de una fila empaquetada (layouts BITS y TILED)
+     * @param grid Grid con el halo actualizado
+     * @param y Fila
+     */
+    void buildBitIndices(const Grid2D& grid, int y);
+
+    /**
+     * @brief Índices de paleta de una fila de bytes (layout BYTES)
+     * @param grid Grid con el halo actualizado
+     * @param y Fila
+     */
+    void buildByteIndices(const Grid2D& grid, int y);
+
+    /**
+     * @brief Índices de paleta de una fila de un campo continuo
+     * @param values Valores de la fila
+     * @param count Celdas
+     */
+    void buildFieldIndices(const float* values, int count);
+
+    /**
+     * @brief Convierte count índices de la fila en píxeles RGBA
+     * @param out Destino (count * 4 bytes)
+     * @param count Celdas
+     * @param table Tablas por canal (channels o fieldChannels)
+     */
+    void mapIndices(uint8_t* out, int count, const uint8_t (*table)[32]) const;
+};
+
+}  // namespace Core
+
+#endif  // CELL_PALETTE_HPP
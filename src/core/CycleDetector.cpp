@@ -0,0 +1,140 @@
+/**
+ * @file CycleDetector.cpp
+ * @brief Implementación del detector de ciclos
+ */
+
+#include "CycleDetector.hpp"
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Core {
+
+CycleDetector::CycleDetector() :
+    hash(0), revision(UINT64_MAX), incremental(false), history {}, historyCount(0), historyNext(0)
+{
+}
+
+void CycleDetector::reset()
+{
+    historyCount = 0;
+    historyNext = 0;
+    cycle = CycleInfo {};
+}
+
+uint64_t CycleDetector::hashTile(const Grid2D& grid, int tx, int ty)
+{
+    const int width = grid.getWidth();
+    const int height = grid.getHeight();
+    const int y0 = ty * Grid2D::TILE_SIZE;
+    const int y1 = std::min(y0 + Grid2D::TILE_SIZE, height);
+    uint64_t tileHash = 0;
+
+    if (grid.getLayout() != GridLayout::BYTES) {
+        // Un tile es una columna de palabras; el relleno de la última palabra puede tener halo.
+        // Las posiciones no dependen del layout: BITS y TILED dan el mismo hash
+        const int wordsPerRow = grid.getWordsPerRow();
+        const uint64_t mask = tx == wordsPerRow - 1 ? grid.getLastWordMask() : ~0ULL;
+        for (int p = 0; p < grid.getPlaneCount(); ++p) {
+            for (int y = y0; y < y1; ++y) {
+                uint64_t word = grid.getBitWord(tx, y, p) & mask;
+                if (word != 0)
+                    tileHash ^= Random::at(word, (static_cast<uint64_t>(p) * height + y) * wordsPerRow + tx);
+            }
+        }
+        return tileHash;
+    }
+
+    // Bytes: grupos de 8 celdas leídos como una palabra
+    const int chunksPerRow = (width + 7) / 8;
+    const int x0 = tx * Grid2D::TILE_SIZE;
+    const int x1 = std::min(x0 + Grid2D::TILE_SIZE, width);
+    for (int y = y0; y < y1; ++y) {
+        const CellState* row = grid.getByteRow(y);
+        for (int x = x0; x < x1; x += 8) {
+            uint64_t word = 0;
+            std::memcpy(&word, row + x, static_cast<size_t>(std::min(8, x1 - x)));
+            if (word != 0)
+                tileHash ^= Random::at(word, static_cast<uint64_t>(y) * chunksPerRow + x / 8);
+        }
+    }
+    return tileHash;
+}
+
+void CycleDetector::record(const Grid2D& grid, int64_t generation, ThreadPool* pool)
+{
+    beginRecord(grid);
+    recordRows(grid, 0, grid.getTilesY(), pool);
+    finishRecord(grid, generation);
+}
+
+void CycleDetector::beginRecord(const Grid2D& grid)
+{
+    const size_t tileCount = static_cast<size_t>(grid.getTilesX()) * grid.getTilesY();
+
+    // Solo un paso con sus tiles cambiados desde el último registro permite actualizar por partes
+    incremental = tileHashes.size() == tileCount && grid.getRevision() == revision + 1;
+    if (tileHashes.size() != tileCount) {
+        tileHashes.assign(tileCount, 0);
+        hash = 0;
+    }
+    rowDeltas.assign(grid.getTilesY(), 0);
+}
+
+void CycleDetector::recordRows(const Grid2D& grid, int begin, int end, ThreadPool* pool)
+{
+    const int tilesX = grid.getTilesX();
+
+    // El hash cambia en el XOR del hash viejo y el nuevo de cada tile recalculado
+    auto rehashRows = [&](int first, int last) {
+        for (int ty = begin + first; ty < begin + last; ++ty) {
+            uint64_t delta = 0;
+            for (int tx = 0; tx < tilesX; ++tx) {
+                if (incremental && !grid.isTileChanged(tx, ty))
+                    continue;
+                size_t index = static_cast<size_t>(ty) * tilesX + tx;
+                uint64_t tileHash = hashTile(grid, tx, ty);
+                delta ^= tileHashes[index] ^ tileHash;
+                tileHashes[index] = tileHash;
+            }
+            rowDeltas[ty] = delta;
+        }
+    };
+    ThreadPool::run(pool, end - begin, rehashRows);
+
+    // hash sigue siendo el XOR de tileHashes: un registro abandonado no lo descuadra
+    for (int ty = begin; ty < end; ++ty)
+        hash ^= rowDeltas[ty];
+}
+
+void CycleDetector::finishRecord(const Grid2D& grid, int64_t generation)
+{
+    revision = grid.getRevision();
+
+    // La coincidencia más reciente da el periodo más corto
+    const int64_t population = grid.getPopulation();
+    const CycleInfo previous = cycle;
+    cycle = CycleInfo {};
+    for (int i = 1; i <= historyCount; ++i) {
+        const Entry& entry = history[(historyNext - i + HISTORY_SIZE) % HISTORY_SIZE];
+        if (entry.hash == hash && entry.population == population && entry.generation < generation) {
+            cycle.period = generation - entry.generation;
+            cycle.startGeneration = previous.period == cycle.period ? previous.startGeneration : entry.generation;
+            break;
+        }
+    }
+
+    history[historyNext] = Entry { generation, hash, population };
+    historyNext = (historyNext + 1) % HISTORY_SIZE;
+    historyCount = std::min(historyCount + 1, HISTORY_SIZE);
+}
+
+void CycleDetector::advance(int64_t generations)
+{
+    // Dentro del ciclo el estado de g y el de g + k * periodo son el mismo
+    for (int i = 0; i < historyCount; ++i)
+        history[i].generation += generations;
+}
+
+}  // namespace Core
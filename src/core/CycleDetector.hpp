@@ -0,0 +1,145 @@
+/**
+ * @file CycleDetector.hpp
+ * @brief Hash incremental del grid y detección de estados repetidos
+ *
+ * El hash del grid es el XOR de los hashes de sus tiles, y el de cada tile el
+ * XOR de Random::at(palabra, posición) sobre sus palabras de 64 celdas no
+ * vacías (tipo Zobrist, por palabras en lugar de por celdas). Tras un paso
+ * solo se recalculan los tiles que los kernels marcaron como cambiados. Una
+ * tabla circular guarda los últimos hashes: si el estado actual coincide con
+ * uno de hace p generaciones, el grid ha entrado en un ciclo de periodo p.
+ */
+
+#ifndef CYCLE_DETECTOR_HPP
+#define CYCLE_DETECTOR_HPP
+
+#include "Grid2D.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+
+class ThreadPool;
+
+/**
+ * @struct CycleInfo
+ * @brief Ciclo detectado (period == 0 si no hay ninguno)
+ */
+struct CycleInfo {
+    int64_t period = 0;           // Generaciones entre dos repeticiones del estado (1 = vida estática)
+    int64_t startGeneration = 0;  // Primera generación registrada cuyo estado se repite
+
+    /**
+     * @brief Verifica si hay un ciclo
+     * @return true si period > 0
+     */
+    bool isDetected() const { return period > 0; }
+};
+
+/**
+ * @class CycleDetector
+ * @brief Hash por tiles del grid y tabla de hashes recientes
+ */
+class CycleDetector {
+public:
+    // Entradas de la tabla de hashes recientes (periodo máximo detectable, en pasos registrados)
+    static constexpr int HISTORY_SIZE = 128;
+
+    /**
+     * @brief Constructor (sin historia)
+     */
+    CycleDetector();
+
+    /**
+     * @brief Olvida la historia y el ciclo (tras ediciones o cambios de regla)
+     */
+    void reset();
+
+    /**
+     * @brief Registra el estado del grid tras un paso
+     *
+     * Si la revisión del grid avanzó exactamente uno desde el último registro,
+     * solo se recalculan los tiles marcados como cambiados; si no, todos.
+     *
+     * @param grid Grid
+     * @param generation Generación del estado actual
+     * @param pool Hilos para recalcular tiles (nullptr = en serie)
+     */
+    void record(const Grid2D& grid, int64_t generation, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Empieza un registro por partes (record() en tres llamadas)
+     *
+     * Entre beginRecord() y finishRecord() el grid no debe cambiar. Un
+     * registro a medias deja el hash cuadrado con los tiles ya recalculados,
+     * así que se puede abandonar sin más.
+     *
+     * @param grid Grid
+     */
+    void beginRecord(const Grid2D& grid);
+
+    /**
+     * @brief Recalcula los tiles de un rango de filas de tiles
+     * @param grid Grid
+     * @param begin Primera fila de tiles
+     * @param end Fila final (exclusiva)
+     * @param pool Hilos para repartir las filas (nullptr = en serie)
+     */
+    void recordRows(const Grid2D& grid, int begin, int end, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Termina un registro por partes (todas las filas recalculadas)
+     * @param grid Grid
+     * @param generation Generación del estado registrado
+     */
+    void finishRecord(const Grid2D& grid, int64_t generation);
+
+    /**
+     * @brief Desplaza la historia tras saltar generaciones dentro del ciclo
+     * @param generations Generaciones saltadas (múltiplo del periodo)
+     */
+    void advance(int64_t generations);
+
+    /**
+     * @brief Obtiene el hash del último estado registrado
+     * @return Hash de 64 bits (0 para un grid vacío)
+     */
+    uint64_t getHash() const { return hash; }
+
+    /**
+     * @brief Obtiene el ciclo detectado en el último registro
+     * @return Ciclo (period == 0 si no hay)
+     */
+    const CycleInfo& getCycle() const { return cycle; }
+
+private:
+    struct Entry {
+        int64_t generation;
+        uint64_t hash;
+        int64_t population;  // Descarta colisiones baratas antes de dar un ciclo por bueno
+    };
+
+    std::vector<uint64_t> tileHashes;  // Índice ty * tilesX + tx
+    std::vector<uint64_t> rowDeltas;   // XOR de los cambios de cada fila de tiles
+    uint64_t hash;
+    uint64_t revision;  // Revisión del grid en el último registro
+    bool incremental;   // El registro en curso solo recalcula los tiles cambiados
+    std::array<Entry, HISTORY_SIZE> history;
+    int historyCount;
+    int historyNext;
+    CycleInfo cycle;
+
+    /**
+     * @brief Hash de un tile
+     * @param grid Grid
+     * @param tx Columna de tiles
+     * @param ty Fila de tiles
+     * @return XOR de los hashes de sus palabras no vacías
+     */
+    static uint64_t hashTile(const Grid2D& grid, int tx, int ty);
+};
+
+}  // namespace Core
+
+#endif  // CYCLE_DETECTOR_HPP
@@ -0,0 +1,393 @@
+/**
+ * @file Ensemble.cpp
+ * @brief Implementación del ensemble de universos por carriles
+ */
+
+#include "Ensemble.hpp"
+#include "BitKernel.hpp"
+#include "Random.hpp"
+#include "SimdKernel.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ENSEMBLE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Core {
+
+namespace {
+
+/**
+ * @brief Filas [y0, y1) de la siguiente generación, una palabra (64 universos) cada vez
+ *
+ * masks recibe por fila tres tramos de wordsPerCell palabras: carriles que
+ * cambiaron, carriles distintos de next (la generación anterior) y vivos.
+ */
+template <typename R>
+void stepRowsImpl(const uint64_t* cells, uint64_t* next, uint64_t* masks, int width, int wordsPerCell, int y0, int y1,
+                  R rule)
+{
+    const ptrdiff_t cellStride = wordsPerCell;
+    const ptrdiff_t rowStride = static_cast<ptrdiff_t>(width + 2) * wordsPerCell;
+
+    for (int y = y0; y < y1; ++y) {
+        uint64_t* changed = masks + static_cast<size_t>(y) * 3 * wordsPerCell;
+        uint64_t* differs = changed + wordsPerCell;
+        uint64_t* alive = differs + wordsPerCell;
+        std::fill(changed, changed + 3 * wordsPerCell, 0);
+
+        for (int x = 0; x < width; ++x) {
+            const ptrdiff_t base = (static_cast<ptrdiff_t>(y + 1) * (width + 2) + (x + 1)) * wordsPerCell;
+            const uint64_t* center = cells + base;
+            for (int w = 0; w < wordsPerCell; ++w) {
+                const uint64_t neighbors[8] = {
+                    center[w - rowStride - cellStride], center[w - rowStride], center[w - rowStride + cellStride],
+                    center[w - cellStride],             center[w + cellStride], center[w + rowStride - cellStride],
+                    center[w + rowStride],              center[w + rowStride + cellStride],
+                };
+                uint64_t b0, b1, b2, b3;
+                BitKernel::countLanes(neighbors, b0, b1, b2, b3);
+                uint64_t result = BitKernel::applyRule(center[w], b0, b1, b2, b3, rule.birthMask, rule.survivalMask);
+
+                changed[w] |= result ^ center[w];
+                differs[w] |= result ^ next[base + w];
+                alive[w] |= result;
+                next[base + w] = result;
+            }
+        }
+    }
+}
+
+#ifdef ENSEMBLE_X86
+
+__attribute__((target("avx2"))) inline void fullAddAvx2(__m256i a, __m256i b, __m256i c, __m256i& sum,
+                                                        __m256i& carry)
+{
+    __m256i ab = _mm256_xor_si256(a, b);
+    sum = _mm256_xor_si256(ab, c);
+    carry = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(ab, c));
+}
+
+// BitKernel::matchCount sobre cuatro palabras
+__attribute__((target("avx2"))) inline __m256i matchCountAvx2(const __m256i count[4], uint16_t mask)
+{
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    __m256i match = _mm256_setzero_si256();
+    for (int n = 0; n <= 8; ++n) {
+        if ((mask & (1u << n)) == 0)
+            continue;
+        __m256i term = ones;
+        for (int bit = 0; bit < 4; ++bit)
+            term = _mm256_and_si256(term, ((n >> bit) & 1) ? count[bit] : _mm256_xor_si256(count[bit], ones));
+        match = _mm256_or_si256(match, term);
+    }
+    return match;
+}
+
+__attribute__((target("avx2"))) inline __m256i load256(const uint64_t* p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+__attribute__((target("avx2"))) inline void orInto(uint64_t* p, __m256i value)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_or_si256(load256(p), value));
+}
+
+/**
+ * @brief stepRowsImpl con cuatro palabras (256 universos) por instrucción
+ */
+template <typename R>
+__attribute__((target("avx2"))) void stepRowsAvx2(const uint64_t* cells, uint64_t* next, uint64_t* masks, int width,
+                                                  int wordsPerCell, int y0, int y1, R rule)
+{
+    const ptrdiff_t cellStride = wordsPerCell;
+    const ptrdiff_t rowStride = static_cast<ptrdiff_t>(width + 2) * wordsPerCell;
+
+    for (int y = y0; y < y1; ++y) {
+        uint64_t* changed = masks + static_cast<size_t>(y) * 3 * wordsPerCell;
+        uint64_t* differs = changed + wordsPerCell;
+        uint64_t* alive = differs + wordsPerCell;
+        std::fill(changed, changed + 3 * wordsPerCell, 0);
+
+        for (int x = 0; x < width; ++x) {
+            const ptrdiff_t base = (static_cast<ptrdiff_t>(y + 1) * (width + 2) + (x + 1)) * wordsPerCell;
+            const uint64_t* center = cells + base;
+            for (int w = 0; w < wordsPerCell; w += Ensemble::GROUP_WORDS) {
+                __m256i sumA, carryA, sumB, carryB, onesCarry, twos, fours;
+                fullAddAvx2(load256(center + w - rowStride - cellStride), load256(center + w - rowStride),
+                            load256(center + w - rowStride + cellStride), sumA, carryA);
+                fullAddAvx2(load256(center + w - cellStride), load256(center + w + cellStride),
+                            load256(center + w + rowStride - cellStride), sumB, carryB);
+                __m256i south = load256(center + w + rowStride);
+                __m256i southEast = load256(center + w + rowStride + cellStride);
+                __m256i sumC = _mm256_xor_si256(south, southEast);
+                __m256i carryC = _mm256_and_si256(south, southEast);
+
+                __m256i count[4];
+                fullAddAvx2(sumA, sumB, sumC, count[0], onesCarry);
+                fullAddAvx2(carryA, carryB, carryC, twos, fours);
+                count[1] = _mm256_xor_si256(twos, onesCarry);
+                __m256i fours2 = _mm256_and_si256(twos, onesCarry);
+                count[2] = _mm256_xor_si256(fours, fours2);
+                count[3] = _mm256_and_si256(fours, fours2);
+
+                __m256i current = load256(center + w);
+                __m256i born = matchCountAvx2(count, rule.birthMask);
+                __m256i keep = matchCountAvx2(count, rule.survivalMask);
+                __m256i result = _mm256_or_si256(_mm256_and_si256(current, keep), _mm256_andnot_si256(current, born));
+
+                uint64_t* out = next + base + w;
+                orInto(changed + w, _mm256_xor_si256(result, current));
+                orInto(differs + w, _mm256_xor_si256(result, load256(out)));
+                orInto(alive + w, result);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+            }
+        }
+    }
+}
+
+#endif  // ENSEMBLE_X86
+
+}  // namespace
+
+Ensemble::Ensemble(int width, int height, int universeCount) :
+    width(width), height(height), universeCount(universeCount),
+    wordsPerCell((universeCount + LANES * GROUP_WORDS - 1) / (LANES * GROUP_WORDS) * GROUP_WORDS),
+    boundary(BoundaryMode::TORUS), birthMask(0), survivalMask(0), generation(0),
+    cells(static_cast<size_t>(height + 2) * (width + 2) * wordsPerCell, 0), nextCells(cells.size(), 0),
+    rowMasks(static_cast<size_t>(height) * 3 * wordsPerCell, 0), freshLanes(wordsPerCell, ~0ULL),
+    outcomes(universeCount, static_cast<uint8_t>(EnsembleOutcome::RUNNING)), settledGenerations(universeCount, -1),
+    runningCount(universeCount)
+{
+    setRule(Rules::fromType(RuleType::CONWAY));
+}
+
+bool Ensemble::supportsRule(const Rule& rule)
+{
+    // B0 encendería el halo muerto y los carriles de relleno
+    return rule.states == 2 && !rule.isLargerThanLife() && (rule.birthMask & 1) == 0;
+}
+
+bool Ensemble::setRule(const Rule& rule)
+{
+    if (!supportsRule(rule))
+        return false;
+    birthMask = rule.birthMask;
+    survivalMask = rule.survivalMask;
+    for (int u = 0; u < universeCount; ++u)
+        resetOutcome(u);
+    std::fill(freshLanes.begin(), freshLanes.end(), ~0ULL);
+    return true;
+}
+
+void Ensemble::seed(int universe, uint64_t seed, float density)
+{
+    // Mismo flujo que Grid2D::randomize sobre un grid BITS: palabra w de la fila y = contador y * palabras + w
+    const uint32_t threshold = Random::toThreshold(density);
+    const int wordsPerRow = (width + 63) / 64;
+    const int word = universe / LANES;
+    const uint64_t bit = 1ULL << (universe % LANES);
+
+    for (int y = 0; y < height; ++y) {
+        for (int w = 0; w < wordsPerRow; ++w) {
+            uint64_t draw = Random::bernoulliWord(seed, static_cast<uint64_t>(y) * wordsPerRow + w, threshold);
+            int cellsInWord = std::min(64, width - w * 64);
+            for (int b = 0; b < cellsInWord; ++b) {
+                uint64_t& target = cells[cellOffset(w * 64 + b, y) + word];
+                target = ((draw >> b) & 1) ? (target | bit) : (target & ~bit);
+            }
+        }
+    }
+    resetOutcome(universe);
+}
+
+CellState Ensemble::getCell(int universe, int x, int y) const
+{
+    uint64_t word = cells[cellOffset(x, y) + universe / LANES];
+    return static_cast<CellState>((word >> (universe % LANES)) & 1);
+}
+
+void Ensemble::setCell(int universe, int x, int y, CellState state)
+{
+    uint64_t& word = cells[cellOffset(x, y) + universe / LANES];
+    uint64_t bit = 1ULL << (universe % LANES);
+    word = state == CellState::ALIVE ? (word | bit) : (word & ~bit);
+    resetOutcome(universe);
+}
+
+void Ensemble::resetOutcome(int universe)
+{
+    if (outcomes[universe] != static_cast<uint8_t>(EnsembleOutcome::RUNNING))
+        runningCount++;
+    outcomes[universe] = static_cast<uint8_t>(EnsembleOutcome::RUNNING);
+    settledGenerations[universe] = -1;
+    freshLanes[universe / LANES] |= 1ULL << (universe % LANES);
+}
+
+void Ensemble::refreshHalo()
+{
+    const size_t bytes = static_cast<size_t>(wordsPerCell) * sizeof(uint64_t);
+    auto fill = [&](int x, int y) {
+        int sx = Grid2D::wrapCoordinate(x, width, boundary);
+        int sy = Grid2D::wrapCoordinate(y, height, boundary);
+        uint64_t* dst = cells.data() + cellOffset(x, y);
+        if (sx < 0 || sy < 0) {
+            std::memset(dst, 0, bytes);
+        } else {
+            std::memcpy(dst, cells.data() + cellOffset(sx, sy), bytes);
+        }
+    };
+
+    // wrapCoordinate resuelve las dos coordenadas a la vez: las esquinas no dependen del orden
+    for (int y = 0; y < height; ++y) {
+        fill(-1, y);
+        fill(width, y);
+    }
+    for (int x = -1; x <= width; ++x) {
+        fill(x, -1);
+        fill(x, height);
+    }
+}
+
+void Ensemble::step(ThreadPool* pool)
+{
+    refreshHalo();
+
+    // Con las reglas predefinidas las máscaras son constantes y matchCount se reduce a unas pocas operaciones
+    auto task = [&](int y0, int y1) {
+        Rules::visit(birthMask, survivalMask, [&](auto rule) {
+#ifdef ENSEMBLE_X86
+            if (SimdKernel::getIsa() >= SimdKernel::Isa::AVX2) {
+                stepRowsAvx2(cells.data(), nextCells.data(), rowMasks.data(), width, wordsPerCell, y0, y1, rule);
+                return;
+            }
+#endif
+            stepRowsImpl(cells.data(), nextCells.data(), rowMasks.data(), width, wordsPerCell, y0, y1, rule);
+        });
+    };
+    ThreadPool::run(pool, height, task);
+
+    cells.swap(nextCells);
+    generation++;
+    updateOutcomes();
+}
+
+void Ensemble::updateOutcomes()
+{
+    for (int w = 0; w < wordsPerCell; ++w) {
+        uint64_t changed = 0, differs = 0, alive = 0;
+        for (int y = 0; y < height; ++y) {
+            const uint64_t* masks = rowMasks.data() + static_cast<size_t>(y) * 3 * wordsPerCell;
+            changed |= masks[w];
+            differs |= masks[wordsPerCell + w];
+            alive |= masks[2 * wordsPerCell + w];
+        }
+        // Sin una generación anterior válida no se puede comparar con ella
+        differs |= freshLanes[w];
+        freshLanes[w] = 0;
+
+        uint64_t settled = ~changed | ~differs;
+        for (uint64_t lanes = settled; lanes != 0; lanes &= lanes - 1) {
+            int universe = w * LANES + std::countr_zero(lanes);
+            if (universe >= universeCount)
+                break;
+            if (outcomes[universe] != static_cast<uint8_t>(EnsembleOutcome::RUNNING))
+                continue;
+
+            uint64_t bit = lanes & -lanes;
+            EnsembleOutcome outcome = EnsembleOutcome::PERIOD_TWO;
+            if ((alive & bit) == 0) {
+                outcome = EnsembleOutcome::EXTINCT;
+            } else if ((changed & bit) == 0) {
+                outcome = EnsembleOutcome::STILL_LIFE;
+            }
+            // El estado final ya existía una (periodo 1) o dos generaciones (periodo 2) antes
+            outcomes[universe] = static_cast<uint8_t>(outcome);
+            settledGenerations[universe] = generation - (outcome == EnsembleOutcome::PERIOD_TWO ? 2 : 1);
+            runningCount--;
+        }
+    }
+}
+
+void Ensemble::getPopulations(std::vector<int64_t>& out) const
+{
+    // Contadores verticales: el bit k de counters[k] de cada palabra es el bit k de la población del carril
+    const int counterBits = std::bit_width(static_cast<uint64_t>(width) * height);
+    std::vector<uint64_t> counters(static_cast<size_t>(counterBits) * wordsPerCell, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const uint64_t* cell = cells.data() + cellOffset(x, y);
+            for (int w = 0; w < wordsPerCell; ++w) {
+                uint64_t carry = cell[w];
+                for (int k = 0; carry != 0; ++k) {
+                    uint64_t& counter = counters[static_cast<size_t>(k) * wordsPerCell + w];
+                    uint64_t nextCarry = counter & carry;
+                    counter ^= carry;
+                    carry = nextCarry;
+                }
+            }
+        }
+    }
+
+    out.assign(universeCount, 0);
+    for (int u = 0; u < universeCount; ++u) {
+        const int w = u / LANES;
+        const int lane = u % LANES;
+        int64_t population = 0;
+        for (int k = 0; k < counterBits; ++k)
+            population |= static_cast<int64_t>((counters[static_cast<size_t>(k) * wordsPerCell + w] >> lane) & 1) << k;
+        out[u] = population;
+    }
+}
+
+EnsembleSummary Ensemble::runBatch(const EnsembleSettings& settings, const std::vector<uint64_t>& seeds,
+                                   ThreadPool* pool)
+{
+    EnsembleSummary summary;
+    if (!supportsRule(settings.rule) || seeds.empty())
+        return summary;
+
+    const int count = static_cast<int>(seeds.size());
+    Ensemble ensemble(settings.width, settings.height, count);
+    ensemble.setRule(settings.rule);
+    ensemble.setBoundary(settings.boundary);
+    for (int u = 0; u < count; ++u)
+        ensemble.seed(u, seeds[u], settings.density);
+
+    while (ensemble.getGeneration() < settings.maxGenerations && !ensemble.isSettled())
+        ensemble.step(pool);
+
+    std::vector<int64_t> populations;
+    ensemble.getPopulations(populations);
+
+    summary.generations = ensemble.getGeneration();
+    summary.results.resize(count);
+    int64_t populationSum = 0;
+    int64_t settledSum = 0;
+    int settledCount = 0;
+    for (int u = 0; u < count; ++u) {
+        EnsembleResult& result = summary.results[u];
+        result.seed = seeds[u];
+        result.outcome = ensemble.getOutcome(u);
+        result.settledGeneration = ensemble.getSettledGeneration(u);
+        result.population = populations[u];
+
+        summary.outcomeCounts[static_cast<int>(result.outcome)]++;
+        summary.maxPopulation = std::max(summary.maxPopulation, result.population);
+        populationSum += result.population;
+        if (result.outcome != EnsembleOutcome::RUNNING) {
+            settledSum += result.settledGeneration;
+            settledCount++;
+        }
+    }
+    summary.meanPopulation = static_cast<double>(populationSum) / count;
+    summary.meanSettledGeneration = settledCount > 0 ? static_cast<double>(settledSum) / settledCount : 0.0;
+    return summary;
+}
+
+}  // namespace Core
@@ -0,0 +1,265 @@
+/**
+ * @file Ensemble.hpp
+ * @brief Muchos universos pequeños independientes avanzados a la vez
+ *
+ * Cada celda guarda una palabra por cada 64 universos: el bit i de la
+ * palabra es la celda en el universo i. Los vecinos de todos los universos
+ * están en las palabras de las celdas vecinas, así que un paso son los
+ * sumadores bit-slice de BitKernel sobre palabras alineadas, sin
+ * desplazamientos, y con AVX2 se procesan 256 universos por instrucción. Los
+ * universos se detienen solos: se detecta por carril la extinción, la vida
+ * estática y las oscilaciones de periodo 2.
+ */
+
+#ifndef ENSEMBLE_HPP
+#define ENSEMBLE_HPP
+
+#include "Grid2D.hpp"
+#include "Rules.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+
+class ThreadPool;
+
+/**
+ * @enum EnsembleOutcome
+ * @brief Cómo terminó un universo del ensemble
+ */
+enum class EnsembleOutcome : uint8_t {
+    RUNNING,     // No se ha estabilizado (todavía o al llegar al límite)
+    EXTINCT,     // Sin celdas vivas
+    STILL_LIFE,  // Estado fijo (periodo 1)
+    PERIOD_TWO,  // Oscila con periodo 2
+    COUNT
+};
+
+/**
+ * @struct EnsembleSettings
+ * @brief Parámetros comunes a todos los universos de un lote
+ */
+struct EnsembleSettings {
+    int width = 64;
+    int height = 64;
+    float density = 0.3f;  // Probabilidad inicial de cada celda (ver Grid2D::randomize)
+    Rule rule = Rules::fromType(RuleType::CONWAY);
+    BoundaryMode boundary = BoundaryMode::TORUS;
+    int64_t maxGenerations = 1000;
+};
+
+/**
+ * @struct EnsembleResult
+ * @brief Resultado de un universo del lote
+ */
+struct EnsembleResult {
+    uint64_t seed = 0;
+    EnsembleOutcome outcome = EnsembleOutcome::RUNNING;
+    int64_t settledGeneration = -1;  // Primera generación del estado final (-1 si sigue en RUNNING)
+    int64_t population = 0;          // Población al terminar el lote
+};
+
+/**
+ * @struct EnsembleSummary
+ * @brief Resultados y estadísticas de un lote
+ */
+struct EnsembleSummary {
+    std::vector<EnsembleResult> results;  // Uno por semilla, en el mismo orden
+    int64_t generations = 0;              // Generaciones simuladas (menos si todos se estabilizan antes)
+    std::array<int, static_cast<int>(EnsembleOutcome::COUNT)> outcomeCounts = {};  // Universos por resultado
+    double meanPopulation = 0.0;
+    int64_t maxPopulation = 0;
+    double meanSettledGeneration = 0.0;  // Media sobre los universos estabilizados
+};
+
+/**
+ * @class Ensemble
+ * @brief Universos de igual tamaño y regla, un carril de bit por universo
+ */
+class Ensemble {
+public:
+    // Universos por palabra
+    static constexpr int LANES = 64;
+    // Las palabras por celda se redondean a este múltiplo (un vector AVX2)
+    static constexpr int GROUP_WORDS = 4;
+
+    /**
+     * @brief Constructor (todos los universos vacíos)
+     * @param width Ancho de cada universo
+     * @param height Alto de cada universo
+     * @param universeCount Número de universos
+     */
+    Ensemble(int width, int height, int universeCount);
+
+    /**
+     * @brief Verifica si una regla se puede avanzar por carriles
+     * @param rule Regla
+     * @return true para reglas B/S de dos estados, radio 1 y sin B0
+     */
+    static bool supportsRule(const Rule& rule);
+
+    /**
+     * @brief Establece la regla de todos los universos
+     * @param rule Regla
+     * @return false (sin cambios) si !supportsRule(rule)
+     */
+    bool setRule(const Rule& rule);
+
+    /**
+     * @brief Establece el modo de borde de todos los universos
+     * @param mode Celdas muertas, toro o espejo
+     */
+    void setBoundary(BoundaryMode mode) { boundary = mode; }
+
+    /**
+     * @brief Obtiene el modo de borde
+     * @return Modo de borde
+     */
+    BoundaryMode getBoundary() const { return boundary; }
+
+    /**
+     * @brief Obtiene el ancho de cada universo
+     * @return Ancho
+     */
+    int getWidth() const { return width; }
+
+    /**
+     * @brief Obtiene el alto de cada universo
+     * @return Alto
+     */
+    int getHeight() const { return height; }
+
+    /**
+     * @brief Obtiene el número de universos
+     * @return Universos
+     */
+    int getUniverseCount() const { return universeCount; }
+
+    /**
+     * @brief Obtiene las generaciones avanzadas
+     * @return Generación actual
+     */
+    int64_t getGeneration() const { return generation; }
+
+    /**
+     * @brief Llena un universo como Grid2D::randomize(density, seed) un grid BITS del mismo tamaño
+     * @param universe Universo
+     * @param seed Semilla
+     * @param density Probabilidad de cada celda
+     */
+    void seed(int universe, uint64_t seed, float density);
+
+    /**
+     * @brief Obtiene una celda de un universo
+     * @param universe Universo
+     * @param x Columna
+     * @param y Fila
+     * @return Estado
+     */
+    CellState getCell(int universe, int x, int y) const;
+
+    /**
+     * @brief Establece una celda de un universo (lo vuelve a RUNNING)
+     * @param universe Universo
+     * @param x Columna
+     * @param y Fila
+     * @param state Estado
+     */
+    void setCell(int universe, int x, int y, CellState state);
+
+    /**
+     * @brief Avanza una generación todos los universos
+     * @param pool Hilos para repartir las filas (nullptr = en serie)
+     */
+    void step(ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Población de cada universo
+     * @param out Destino (se redimensiona a getUniverseCount())
+     */
+    void getPopulations(std::vector<int64_t>& out) const;
+
+    /**
+     * @brief Obtiene cómo terminó un universo
+     * @param universe Universo
+     * @return Resultado (RUNNING si aún no se ha estabilizado)
+     */
+    EnsembleOutcome getOutcome(int universe) const { return static_cast<EnsembleOutcome>(outcomes[universe]); }
+
+    /**
+     * @brief Obtiene la primera generación del estado final de un universo
+     * @param universe Universo
+     * @return Generación, o -1 si sigue en RUNNING
+     */
+    int64_t getSettledGeneration(int universe) const { return settledGenerations[universe]; }
+
+    /**
+     * @brief Verifica si todos los universos se han estabilizado
+     * @return true si ninguno está en RUNNING
+     */
+    bool isSettled() const { return runningCount == 0; }
+
+    /**
+     * @brief Ejecuta un lote: un universo por semilla hasta estabilizarse o llegar al límite
+     * @param settings Tamaño, densidad, regla, borde y límite de generaciones
+     * @param seeds Semillas (ver seed())
+     * @param pool Hilos (nullptr = en serie)
+     * @return Resultado de cada universo y estadísticas del lote (vacío si la regla no se admite)
+     */
+    static EnsembleSummary runBatch(const EnsembleSettings& settings, const std::vector<uint64_t>& seeds,
+                                    ThreadPool* pool = nullptr);
+
+private:
+    int width;
+    int height;
+    int universeCount;
+    int wordsPerCell;  // Múltiplo de GROUP_WORDS
+    BoundaryMode boundary;
+    uint16_t birthMask;
+    uint16_t survivalMask;
+    int64_t generation;
+
+    // (height + 2) x (width + 2) celdas con halo, wordsPerCell palabras cada una
+    std::vector<uint64_t> cells;
+    std::vector<uint64_t> nextCells;  // Tras swap: la generación anterior
+
+    // Por fila: carriles que cambiaron, que difieren de hace dos generaciones y vivos (3 * wordsPerCell)
+    std::vector<uint64_t> rowMasks;
+    std::vector<uint64_t> freshLanes;  // Carriles sin generación anterior válida (recién llenados o editados)
+
+    std::vector<uint8_t> outcomes;
+    std::vector<int64_t> settledGenerations;
+    int runningCount;
+
+    /**
+     * @brief Posición de la primera palabra de una celda
+     * @param x Columna (-1 a width)
+     * @param y Fila (-1 a height)
+     * @return Índice en cells
+     */
+    size_t cellOffset(int x, int y) const
+    {
+        return (static_cast<size_t>(y + 1) * (width + 2) + (x + 1)) * wordsPerCell;
+    }
+
+    /**
+     * @brief Copia en el halo las celdas indicadas por el modo de borde
+     */
+    void refreshHalo();
+
+    /**
+     * @brief Marca los universos que se estabilizaron en el último paso
+     */
+    void updateOutcomes();
+
+    /**
+     * @brief Vuelve a RUNNING un universo editado
+     * @param universe Universo
+     */
+    void resetOutcome(int universe);
+};
+
+}  // namespace Core
+
+#endif  // ENSEMBLE_HPP
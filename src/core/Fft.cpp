@@ -0,0 +1,194 @@
+/**
+ * @file Fft.cpp
+ * @brief Implementación de la FFT radix-2 y la FFT 2D real
+ */
+
+#include "Fft.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace Core {
+
+namespace {
+
+using Complex = std::complex<float>;
+
+// Columnas que se transforman juntas: cada fila aporta un tramo contiguo de memoria
+const int COLUMN_BLOCK = 8;
+
+// Producto sin las comprobaciones de NaN/Inf de operator* (que sin -ffast-math es una llamada a libgcc)
+inline Complex multiply(Complex a, Complex b)
+{
+    return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+}  // namespace
+
+Fft::Fft(int size) : size(size), twiddles(size / 2), bitReverse(size)
+{
+    for (int k = 0; k < size / 2; ++k) {
+        double angle = -2.0 * std::numbers::pi * k / size;
+        twiddles[k] = Complex(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+
+    int bits = 0;
+    while ((1 << bits) < size)
+        bits++;
+    for (int i = 0; i < size; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b)
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        bitReverse[i] = reversed;
+    }
+}
+
+int Fft::nextPowerOfTwo(int n)
+{
+    int power = 1;
+    while (power < n)
+        power <<= 1;
+    return power;
+}
+
+void Fft::forward(Complex* data) const
+{
+    transform(data, false);
+}
+
+void Fft::inverse(Complex* data) const
+{
+    transform(data, true);
+}
+
+void Fft::transform(Complex* data, bool conjugate) const
+{
+    for (int i = 0; i < size; ++i) {
+        if (i < bitReverse[i])
+            std::swap(data[i], data[bitReverse[i]]);
+    }
+
+    for (int length = 2; length <= size; length <<= 1) {
+        const int half = length / 2;
+        const int stride = size / length;
+        for (int start = 0; start < size; start += length) {
+            for (int j = 0; j < half; ++j) {
+                Complex twiddle = twiddles[j * stride];
+                if (conjugate)
+                    twiddle = std::conj(twiddle);
+                Complex even = data[start + j];
+                Complex odd = multiply(data[start + j + half], twiddle);
+                data[start + j] = even + odd;
+                data[start + j + half] = even - odd;
+            }
+        }
+    }
+}
+
+RealFft2D::RealFft2D(int width, int height) :
+    width(width), height(height), rowFft(width / 2), columnFft(height), rowTwiddles(width / 2 + 1)
+{
+    for (int k = 0; k <= width / 2; ++k) {
+        double angle = -2.0 * std::numbers::pi * k / width;
+        rowTwiddles[k] = Complex(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+}
+
+void RealFft2D::forward(const float* input, Complex* spectrum, ThreadPool* pool) const
+{
+    const int half = width / 2;
+    const int spectrumWidth = getSpectrumWidth();
+
+    // Filas: z[m] = x[2m] + i x[2m+1]; las transformadas de pares (Ze) e impares (Zo) se separan
+    // por simetría y X[k] = Ze[k] + e^(-2 pi i k / N) Zo[k]
+    ThreadPool::run(pool, height, [&](int begin, int end) {
+        std::vector<Complex> packed(half);
+        for (int y = begin; y < end; ++y) {
+            const float* row = input + static_cast<size_t>(y) * width;
+            for (int m = 0; m < half; ++m)
+                packed[m] = Complex(row[2 * m], row[2 * m + 1]);
+            rowFft.forward(packed.data());
+
+            Complex* out = spectrum + static_cast<size_t>(y) * spectrumWidth;
+            for (int k = 0; k <= half; ++k) {
+                Complex z = packed[k % half];
+                Complex mirror = std::conj(packed[(half - k) % half]);
+                Complex even = (z + mirror) * 0.5f;
+                Complex odd = multiply(z - mirror, Complex(0.0f, -0.5f));
+                out[k] = even + multiply(rowTwiddles[k], odd);
+            }
+        }
+    });
+
+    ThreadPool::run(pool, spectrumWidth, [&](int begin, int end) { transformColumns(spectrum, begin, end, false); });
+}
+
+void RealFft2D::inverse(Complex* spectrum, float* output, ThreadPool* pool) const
+{
+    const int half = width / 2;
+    const int spectrumWidth = getSpectrumWidth();
+
+    ThreadPool::run(pool, spectrumWidth, [&](int begin, int end) { transformColumns(spectrum, begin, end, true); });
+
+    // Proceso inverso de las filas: Z[k] = 2 Ze[k] + 2i Zo[k] da N veces la señal tras la inversa de N/2
+    ThreadPool::run(pool, height, [&](int begin, int end) {
+        std::vector<Complex> packed(half);
+        for (int y = begin; y < end; ++y) {
+            const Complex* in = spectrum + static_cast<size_t>(y) * spectrumWidth;
+            for (int k = 0; k < half; ++k) {
+                Complex x = in[k];
+                Complex mirror = std::conj(in[half - k]);
+                Complex odd = multiply(x - mirror, std::conj(rowTwiddles[k]));
+                packed[k] = (x + mirror) + multiply(Complex(0.0f, 1.0f), odd);
+            }
+            rowFft.inverse(packed.data());
+
+            float* row = output + static_cast<size_t>(y) * width;
+            for (int m = 0; m < half; ++m) {
+                row[2 * m] = packed[m].real();
+                row[2 * m + 1] = packed[m].imag();
+            }
+        }
+    });
+}
+
+void RealFft2D::multiplySpectrum(Complex* spectrum, const Complex* factor, ThreadPool* pool) const
+{
+    const int spectrumWidth = getSpectrumWidth();
+    ThreadPool::run(pool, height, [&](int begin, int end) {
+        const size_t last = static_cast<size_t>(end) * spectrumWidth;
+        for (size_t i = static_cast<size_t>(begin) * spectrumWidth; i < last; ++i)
+            spectrum[i] = multiply(spectrum[i], factor[i]);
+    });
+}
+
+void RealFft2D::transformColumns(Complex* spectrum, int begin, int end, bool inverse) const
+{
+    const int spectrumWidth = getSpectrumWidth();
+    std::vector<Complex> columns(static_cast<size_t>(COLUMN_BLOCK) * height);
+
+    for (int c0 = begin; c0 < end; c0 += COLUMN_BLOCK) {
+        const int count = std::min(COLUMN_BLOCK, end - c0);
+        for (int y = 0; y < height; ++y) {
+            const Complex* row = spectrum + static_cast<size_t>(y) * spectrumWidth + c0;
+            for (int j = 0; j < count; ++j)
+                columns[static_cast<size_t>(j) * height + y] = row[j];
+        }
+        for (int j = 0; j < count; ++j) {
+            Complex* column = columns.data() + static_cast<size_t>(j) * height;
+            if (inverse) {
+                columnFft.inverse(column);
+            } else {
+                columnFft.forward(column);
+            }
+        }
+        for (int y = 0; y < height; ++y) {
+            Complex* row = spectrum + static_cast<size_t>(y) * spectrumWidth + c0;
+            for (int j = 0; j < count; ++j)
+                row[j] = columns[static_cast<size_t>(j) * height + y];
+        }
+    }
+}
+
+}  // namespace Core
@@ -0,0 +1,156 @@
+/**
+ * @file Fft.hpp
+ * @brief Transformada rápida de Fourier radix-2 y su versión 2D real
+ *
+ * Fft es una FFT compleja iterativa in situ sobre potencias de dos. RealFft2D
+ * transforma campos reales: cada fila de N reales se empaqueta como N/2
+ * complejos (pares en la parte real, impares en la imaginaria), de modo que
+ * solo se calculan N/2 + 1 columnas del espectro. Filas y columnas se
+ * reparten entre los hilos de un ThreadPool.
+ */
+
+#ifndef FFT_HPP
+#define FFT_HPP
+
+#include <complex>
+#include <vector>
+
+namespace Core {
+
+class ThreadPool;
+
+/**
+ * @class Fft
+ * @brief FFT compleja de tamaño fijo (potencia de dos) con tablas precalculadas
+ */
+class Fft {
+public:
+    /**
+     * @brief Constructor
+     * @param size Número de muestras (potencia de dos, >= 1)
+     */
+    explicit Fft(int size);
+
+    /**
+     * @brief Obtiene el número de muestras
+     * @return Tamaño de la transformada
+     */
+    int getSize() const { return size; }
+
+    /**
+     * @brief Transformada directa in situ (X[k] = sum x[n] e^(-2 pi i k n / N))
+     * @param data size muestras
+     */
+    void forward(std::complex<float>* data) const;
+
+    /**
+     * @brief Transformada inversa in situ sin normalizar (devuelve N veces la señal)
+     * @param data size coeficientes
+     */
+    void inverse(std::complex<float>* data) const;
+
+    /**
+     * @brief Verifica si un número es potencia de dos
+     * @param n Número
+     * @return true si n = 2^k con k >= 0
+     */
+    static bool isPowerOfTwo(int n) { return n > 0 && (n & (n - 1)) == 0; }
+
+    /**
+     * @brief Menor potencia de dos mayor o igual que n
+     * @param n Número (>= 1)
+     * @return Potencia de dos
+     */
+    static int nextPowerOfTwo(int n);
+
+private:
+    int size;
+    std::vector<std::complex<float>> twiddles;  // e^(-2 pi i k / size), k < size / 2
+    std::vector<int> bitReverse;                // Permutación de entrada
+
+    /**
+     * @brief Mariposas sobre datos ya permutados
+     * @param data Muestras
+     * @param conjugate true para la inversa (giros conjugados)
+     */
+    void transform(std::complex<float>* data, bool conjugate) const;
+};
+
+/**
+ * @class RealFft2D
+ * @brief FFT 2D de campos reales periódicos width x height (potencias de dos)
+ *
+ * El espectro ocupa height filas de getSpectrumWidth() = width/2 + 1
+ * coeficientes; el resto se deduce por simetría hermítica.
+ */
+class RealFft2D {
+public:
+    /**
+     * @brief Constructor
+     * @param width Ancho (potencia de dos, >= 2)
+     * @param height Alto (potencia de dos, >= 1)
+     */
+    RealFft2D(int width, int height);
+
+    /**
+     * @brief Obtiene el ancho del campo
+     * @return Ancho
+     */
+    int getWidth() const { return width; }
+
+    /**
+     * @brief Obtiene el alto del campo
+     * @return Alto
+     */
+    int getHeight() const { return height; }
+
+    /**
+     * @brief Coeficientes por fila del espectro
+     * @return width / 2 + 1
+     */
+    int getSpectrumWidth() const { return width / 2 + 1; }
+
+    /**
+     * @brief Espectro de un campo real
+     * @param input width * height valores, fila a fila
+     * @param spectrum Destino de height * getSpectrumWidth() coeficientes
+     * @param pool Hilos (nullptr = en serie)
+     */
+    void forward(const float* input, std::complex<float>* spectrum, ThreadPool* pool) const;
+
+    /**
+     * @brief Campo real a partir de su espectro, sin normalizar (width * height veces)
+     * @param spectrum Coeficientes (se usan como espacio de trabajo y quedan modificados)
+     * @param output Destino de width * height valores
+     * @param pool Hilos (nullptr = en serie)
+     */
+    void inverse(std::complex<float>* spectrum, float* output, ThreadPool* pool) const;
+
+    /**
+     * @brief Producto punto a punto de dos espectros (convolución circular en el espacio)
+     * @param spectrum Espectro que se multiplica in situ
+     * @param factor Espectro del mismo tamaño
+     * @param pool Hilos (nullptr = en serie)
+     */
+    void multiplySpectrum(std::complex<float>* spectrum, const std::complex<float>* factor, ThreadPool* pool) const;
+
+private:
+    int width;
+    int height;
+    Fft rowFft;                                    // Filas empaquetadas: width / 2 complejos
+    Fft columnFft;                                 // Columnas del espectro: height complejos
+    std::vector<std::complex<float>> rowTwiddles;  // e^(-2 pi i k / width), k <= width / 2
+
+    /**
+     * @brief Transforma las columnas [begin, end) del espectro
+     * @param spectrum Espectro
+     * @param begin Primera columna
+     * @param end Columna final (exclusiva)
+     * @param inverse true para la inversa
+     */
+    void transformColumns(std::complex<float>* spectrum, int begin, int end, bool inverse) const;
+};
+
+}  // namespace Core
+
+#endif  // FFT_HPP
@@ -4,44 +4,400 @@
  */
 
 #include "Grid2D.hpp"
-#include <random>
+#include "Random.hpp"
+#include "ThreadPool.hpp"
 #include <algorithm>
+#include <bit>
+#include <random>
+#include <utility>
 
 namespace Core {
 
-Grid2D::Grid2D(int width, int height) : width(width), height(height), cells(width * height, CellState::DEAD) { }
+namespace {
+
+// Intercala los bits de x (pares) e y (impares): orden de la curva Z
+uint64_t mortonCode(uint32_t x, uint32_t y)
+{
+    auto spread = [](uint64_t v) {
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+        v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        v = (v | (v << 2)) & 0x3333333333333333ULL;
+        v = (v | (v << 1)) & 0x5555555555555555ULL;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+}  // namespace
+
+Grid2D::Grid2D(int width, int height, GridLayout layout) :
+    width(width), height(height), layout(layout), boundary(BoundaryMode::DEAD), stateCount(2), byteStride(width + 2),
+    planeCount(1), wordsPerRow((width + 63) / 64), bitStride(wordsPerRow + 2),
+    lastWordMask(width % 64 == 0 ? ~0ULL : (1ULL << (width % 64)) - 1), tilesX((width + TILE_SIZE - 1) / TILE_SIZE),
+    tilesY((height + TILE_SIZE - 1) / TILE_SIZE), tileChanged(static_cast<size_t>(tilesX) * tilesY, 1), revision(0),
+    population(0)
+{
+    allocate();
+}
+
+void Grid2D::allocate()
+{
+    if (layout == GridLayout::BITS) {
+        bits.assign(static_cast<size_t>(height + 2) * planeCount * bitStride, 0);
+        backBits.assign(bits.size(), 0);
+    } else if (layout == GridLayout::TILED) {
+        // Tiles interiores ordenados por código de Morton; después, el anillo de halo
+        std::vector<std::pair<uint64_t, size_t>> order;
+        order.reserve(static_cast<size_t>(tilesX) * tilesY);
+        for (int ty = 0; ty < tilesY; ++ty) {
+            for (int tx = 0; tx < tilesX; ++tx)
+                order.emplace_back(mortonCode(tx, ty), static_cast<size_t>(ty + 1) * (tilesX + 2) + (tx + 1));
+        }
+        std::sort(order.begin(), order.end());
+
+        const size_t tileWords = static_cast<size_t>(planeCount) * TILE_SIZE;
+        tileSlots.assign(static_cast<size_t>(tilesX + 2) * (tilesY + 2), SIZE_MAX);
+        size_t next = 0;
+        for (const auto& entry : order) {
+            tileSlots[entry.second] = next;
+            next += tileWords;
+        }
+        for (size_t& slot : tileSlots) {
+            if (slot == SIZE_MAX) {
+                slot = next;
+                next += tileWords;
+            }
+        }
+        bits.assign(next, 0);
+        backBits.assign(bits.size(), 0);
+    } else {
+        cells.assign(static_cast<size_t>(height + 2) * byteStride, CellState::DEAD);
+        backCells.assign(cells.size(), CellState::DEAD);
+    }
+}
 
 CellState Grid2D::getCell(int x, int y) const
 {
     if (!isValid(x, y))
         return CellState::DEAD;
+    if (layout != GridLayout::BYTES) {
+        int state = 0;
+        for (int p = 0; p < planeCount; ++p)
+            state |= static_cast<int>((getBitWord(x >> 6, y, p) >> (x & 63)) & 1) << p;
+        return static_cast<CellState>(state);
+    }
     return cells[getIndex(x, y)];
 }
 
 void Grid2D::setCell(int x, int y, CellState state)
 {
-    if (isValid(x, y)) {
+    if (!isValid(x, y))
+        return;
+    tileChanged[static_cast<size_t>(y / TILE_SIZE) * tilesX + x / TILE_SIZE] = 1;
+    revision++;
+    if (static_cast<int>(state) >= stateCount)
+        state = CellState::DEAD;
+    CellState old;
+    if (layout != GridLayout::BYTES) {
+        uint64_t mask = 1ULL << (x & 63);
+        int oldState = 0;
+        for (int p = 0; p < planeCount; ++p) {
+            uint64_t& word = bits[getWordIndex(x >> 6, y, p)];
+            oldState |= static_cast<int>((word >> (x & 63)) & 1) << p;
+            word = ((static_cast<int>(state) >> p) & 1) ? (word | mask) : (word & ~mask);
+        }
+        old = static_cast<CellState>(oldState);
+    } else {
+        old = cells[getIndex(x, y)];
         cells[getIndex(x, y)] = state;
     }
+    population += (state == CellState::ALIVE) - (old == CellState::ALIVE);
+}
+
+void Grid2D::setStateCount(int states)
+{
+    states = std::clamp(states, 2, MAX_STATES);
+    if (states == stateCount)
+        return;
+
+    // Estados que dejan de existir pasan a DEAD
+    if (states < stateCount) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (static_cast<int>(getCell(x, y)) >= states)
+                    setCell(x, y, CellState::DEAD);
+            }
+        }
+    }
+    stateCount = states;
+
+    int planes = 1;
+    while ((1 << planes) < states)
+        planes++;
+
+    if (layout == GridLayout::BITS && planes != planeCount) {
+        // Reempaquetar con el nuevo número de planos (los planos altos de los estados válidos son 0)
+        std::vector<uint64_t> packed(static_cast<size_t>(height + 2) * planes * bitStride, 0);
+        int kept = std::min(planes, planeCount);
+        for (int y = 0; y < height; ++y) {
+            for (int p = 0; p < kept; ++p) {
+                std::copy_n(getBitRow(y, p), wordsPerRow,
+                            packed.begin() + (static_cast<size_t>(y + 1) * planes + p) * bitStride + 1);
+            }
+        }
+        bits.swap(packed);
+        backBits.assign(bits.size(), 0);
+        planeCount = planes;
+    } else if (layout == GridLayout::TILED && planes != planeCount) {
+        // Cambia el tamaño de cada tile: se rehace la tabla y se vuelven a escribir los estados
+        std::vector<CellState> states;
+        readStates(states);
+        planeCount = planes;
+        allocate();
+        writeStates(states);
+    }
+    markAllTilesChanged();
+    revision++;
+}
+
+void Grid2D::readStates(std::vector<CellState>& out) const
+{
+    out.resize(static_cast<size_t>(width) * height);
+    if (layout == GridLayout::BYTES) {
+        for (int y = 0; y < height; ++y)
+            std::copy_n(getByteRow(y), width, out.begin() + static_cast<size_t>(y) * width);
+        return;
+    }
+
+    for (int y = 0; y < height; ++y) {
+        CellState* row = out.data() + static_cast<size_t>(y) * width;
+        std::fill(row, row + width, CellState::DEAD);
+        for (int p = 0; p < planeCount; ++p) {
+            for (int w = 0; w < wordsPerRow; ++w) {
+                uint64_t word = getBitWord(w, y, p);
+                int cellsInWord = std::min(64, width - w * 64);
+                for (int b = 0; b < cellsInWord; ++b) {
+                    uint8_t bit = static_cast<uint8_t>((word >> b) & 1);
+                    row[w * 64 + b] = static_cast<CellState>(static_cast<uint8_t>(row[w * 64 + b]) | (bit << p));
+                }
+            }
+        }
+    }
+}
+
+void Grid2D::writeStates(const std::vector<CellState>& states)
+{
+    if (layout == GridLayout::BYTES) {
+        for (int y = 0; y < height; ++y)
+            std::copy_n(states.begin() + static_cast<size_t>(y) * width, width, cells.begin() + getByteOffset(y));
+    } else {
+        std::fill(bits.begin(), bits.end(), 0);
+        for (int y = 0; y < height; ++y) {
+            const CellState* row = states.data() + static_cast<size_t>(y) * width;
+            for (int p = 0; p < planeCount; ++p) {
+                for (int x = 0; x < width; ++x)
+                    bits[getWordIndex(x >> 6, y, p)] |= static_cast<uint64_t>((static_cast<uint8_t>(row[x]) >> p) & 1)
+                                                        << (x & 63);
+            }
+        }
+    }
+    population = std::count(states.begin(), states.end(), CellState::ALIVE);
+    markAllTilesChanged();
+    revision++;
+}
+
+void Grid2D::setBoundary(BoundaryMode mode)
+{
+    boundary = mode;
+    markAllTilesChanged();
+    revision++;
+}
+
+const char* Grid2D::getBoundaryName(BoundaryMode mode)
+{
+    switch (mode) {
+    case BoundaryMode::DEAD:
+        return "Dead";
+    case BoundaryMode::TORUS:
+        return "Torus";
+    case BoundaryMode::MIRROR:
+        return "Mirror";
+    default:
+        return "Unknown";
+    }
+}
+
+int Grid2D::wrapCoordinate(int v, int size, BoundaryMode mode)
+{
+    if (v >= 0 && v < size)
+        return v;
+    switch (mode) {
+    case BoundaryMode::TORUS:
+        return ((v % size) + size) % size;
+    case BoundaryMode::MIRROR: {
+        // Periodo 2*size: 0..size-1 y luego size-1..0
+        int period = 2 * size;
+        int m = ((v % period) + period) % period;
+        return m < size ? m : period - 1 - m;
+    }
+    default:
+        return -1;
+    }
+}
+
+void Grid2D::refreshHalo()
+{
+    // Fila/columna de origen de cada lado fantasma (-1 = muerta)
+    const int top = wrapCoordinate(-1, height, boundary);
+    const int bottom = wrapCoordinate(height, height, boundary);
+    const int left = wrapCoordinate(-1, width, boundary);
+    const int right = wrapCoordinate(width, width, boundary);
+
+    if (layout == GridLayout::BYTES) {
+        auto fillRow = [&](int ghost, int source) {
+            CellState* row = cells.data() + getByteOffset(ghost);
+            if (source < 0) {
+                std::fill_n(row, width, CellState::DEAD);
+            } else {
+                std::copy_n(cells.begin() + getByteOffset(source), width, row);
+            }
+        };
+        fillRow(-1, top);
+        fillRow(height, bottom);
+        for (int y = -1; y <= height; ++y) {
+            CellState* row = cells.data() + getByteOffset(y);
+            row[-1] = left < 0 ? CellState::DEAD : row[left];
+            row[width] = right < 0 ? CellState::DEAD : row[right];
+        }
+        return;
+    }
+
+    if (layout == GridLayout::TILED) {
+        // Cada celda fantasma cae en un tile del anillo o en el relleno de un tile parcial del borde
+        auto fillGhost = [&](int x, int y) {
+            int sourceX = wrapCoordinate(x, width, boundary);
+            int sourceY = wrapCoordinate(y, height, boundary);
+            int state = sourceX < 0 || sourceY < 0 ? 0 : static_cast<int>(getCell(sourceX, sourceY));
+            int w = (x + 64) / 64 - 1;
+            uint64_t mask = 1ULL << (x & 63);
+            for (int p = 0; p < planeCount; ++p) {
+                uint64_t& word = bits[getWordIndex(w, y, p)];
+                word = ((state >> p) & 1) ? (word | mask) : (word & ~mask);
+            }
+        };
+        for (int x = -1; x <= width; ++x) {
+            fillGhost(x, -1);
+            fillGhost(x, height);
+        }
+        for (int y = 0; y < height; ++y) {
+            fillGhost(-1, y);
+            fillGhost(width, y);
+        }
+        return;
+    }
+
+    const int tailBit = width % 64;
+    for (int p = 0; p < planeCount; ++p) {
+        auto fillRow = [&](int ghost, int source) {
+            uint64_t* row = bits.data() + getBitOffset(ghost, p);
+            if (source < 0) {
+                std::fill_n(row, wordsPerRow, 0);
+            } else {
+                std::copy_n(bits.begin() + getBitOffset(source, p), wordsPerRow, row);
+            }
+        };
+        fillRow(-1, top);
+        fillRow(height, bottom);
+
+        for (int y = -1; y <= height; ++y) {
+            uint64_t* row = bits.data() + getBitOffset(y, p);
+            auto cell = [&](int x) -> uint64_t { return x < 0 ? 0 : (row[x >> 6] >> (x & 63)) & 1; };
+            uint64_t leftCell = cell(left);
+            uint64_t rightCell = cell(right);
+
+            // Izquierda: bit 63 de la palabra -1. Derecha: primer bit de relleno o palabra wordsPerRow
+            row[-1] = leftCell << 63;
+            if (tailBit != 0) {
+                row[wordsPerRow - 1] = (row[wordsPerRow - 1] & lastWordMask) | (rightCell << tailBit);
+                row[wordsPerRow] = 0;
+            } else {
+                row[wordsPerRow] = rightCell;
+            }
+        }
+    }
 }
 
 void Grid2D::clear()
 {
     std::fill(cells.begin(), cells.end(), CellState::DEAD);
+    std::fill(bits.begin(), bits.end(), 0);
+    population = 0;
+    markAllTilesChanged();
+    revision++;
+}
+
+void Grid2D::swapTileChanges(std::vector<uint8_t>& next)
+{
+    tileChanged.swap(next);
+}
+
+void Grid2D::markAllTilesChanged()
+{
+    std::fill(tileChanged.begin(), tileChanged.end(), 1);
+}
+
+void Grid2D::swapBuffers(const StepCounts& step)
+{
+    cells.swap(backCells);
+    bits.swap(backBits);
+    population += step.births - step.deaths;
+    lastStep = step;
+    revision++;
 }
 
 void Grid2D::randomize(float probability)
 {
     static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
+    randomize(probability, (static_cast<uint64_t>(rd()) << 32) | rd());
+}
 
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            CellState state = (dis(gen) < probability) ? CellState::ALIVE : CellState::DEAD;
-            setCell(x, y, state);
+void Grid2D::randomize(float probability, uint64_t seed, ThreadPool* pool)
+{
+    const uint32_t threshold = Random::toThreshold(probability);
+    std::vector<int64_t> rowPopulation(height, 0);
+
+    // Cada fila solo depende de sus contadores: las bandas se llenan en cualquier orden
+    auto fillRows = [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            int64_t count = 0;
+            for (int w = 0; w < wordsPerRow; ++w) {
+                uint64_t word = Random::bernoulliWord(seed, static_cast<uint64_t>(y) * wordsPerRow + w, threshold);
+                if (w == wordsPerRow - 1)
+                    word &= lastWordMask;
+                count += std::popcount(word);
+
+                if (layout != GridLayout::BYTES) {
+                    bits[getWordIndex(w, y, 0)] = word;
+                    for (int p = 1; p < planeCount; ++p)
+                        bits[getWordIndex(w, y, p)] = 0;
+                } else {
+                    CellState* row = cells.data() + getByteOffset(y) + w * 64;
+                    int cellsInWord = std::min(64, width - w * 64);
+                    for (int b = 0; b < cellsInWord; ++b)
+                        row[b] = static_cast<CellState>((word >> b) & 1);
+                }
+            }
+            rowPopulation[y] = count;
         }
-    }
+    };
+    ThreadPool::run(pool, height, fillRows);
+
+    population = 0;
+    for (int64_t count : rowPopulation)
+        population += count;
+    markAllTilesChanged();
+    revision++;
 }
 
 int Grid2D::countAliveNeighbors(int x, int y) const
@@ -55,10 +411,10 @@ int Grid2D::countAliveNeighbors(int x, int y) const
             if (dx == 0 && dy == 0)
                 continue;
 
-            int nx = x + dx;
-            int ny = y + dy;
+            int nx = wrapCoordinate(x + dx, width, boundary);
+            int ny = wrapCoordinate(y + dy, height, boundary);
 
-            if (isValid(nx, ny) && getCell(nx, ny) == CellState::ALIVE) {
+            if (nx >= 0 && ny >= 0 && getCell(nx, ny) == CellState::ALIVE) {
                 count++;
             }
         }
@@ -67,9 +423,9 @@ int Grid2D::countAliveNeighbors(int x, int y) const
     return count;
 }
 
-int Grid2D::getIndex(int x, int y) const
+size_t Grid2D::getIndex(int x, int y) const
 {
-    return y * width + x;
+    return getByteOffset(y) + x;
 }
 
 bool Grid2D::isValid(int x, int y) const
@@ -77,39 +433,4 @@ bool Grid2D::isValid(int x, int y) const
     return x >= 0 && x < width && y >= 0 && y < height;
 }
 
-void Grid2D::getCellColor(int x, int y, float& r, float& g, float& b) const
-{
-    CellState state = getCell(x, y);
-
-    if (state == CellState::DEAD) {
-        // Células muertas muy oscuras
-        r = 0.1f;
-        g = 0.1f;
-        b = 0.15f;
-        return;
-    }
-
-    // Células vivas: color según número de vecinos
-    int neighbors = countAliveNeighbors(x, y);
-    float intensity = 0.3f + (neighbors / 8.0f) * 0.7f;  // 0.3 a 1.0
-
-    if (neighbors <= 2) {
-        r = 0.0f;
-        g = neighbors / 2.0f * 0.5f;
-        b = intensity;
-    } else if (neighbors <= 4) {
-        r = 0.0f;
-        g = intensity;
-        b = (4.0f - neighbors) / 2.0f * intensity;
-    } else if (neighbors <= 6) {
-        r = (neighbors - 4.0f) / 2.0f * intensity;
-        g = intensity;
-        b = 0.0f;
-    } else {
-        r = intensity;
-        g = (8.0f - neighbors) / 2.0f * 0.5f;
-        b = 0.0f;
-    }
-}
-
 }  // namespace Core
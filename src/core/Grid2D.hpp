@@ -2,7 +2,20 @@
  * @file Grid2D.hpp
  * @brief Grilla 2D para simulación de autómatas celulares
  *
- * Representa el estado del "universo" discreto en 2D.
+ * Representa el estado del "universo" discreto en 2D. Cada fila lleva un
+ * halo de celdas fantasma (una fila arriba/abajo y una celda a cada lado)
+ * que refreshHalo() rellena según el modo de borde, de modo que los kernels
+ * leen sus vecinos sin comprobar límites.
+ *
+ * El layout TILED guarda las celdas empaquetadas en tiles de 64x64: cada
+ * plano de un tile son 64 palabras contiguas (8 líneas de caché; 8 tiles
+ * ocupan una página de 4 KB) y los tiles siguen el orden de Morton (curva Z),
+ * de modo que los tiles vecinos en 2D quedan cerca en memoria. El halo es un
+ * anillo de tiles alrededor de la grilla.
+ *
+ * Hay dos buffers con la misma forma: el frontal (getCell, getBitRow, ...)
+ * es el que ven los lectores y el trasero es el destino del siguiente paso.
+ * swapBuffers() los intercambia en O(1).
  */
 
 #ifndef GRID2D_HPP
@@ -10,9 +23,12 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
 namespace Core {
 
+class ThreadPool;
+
 /**
  * @enum CellState
  * @brief Estados posibles de una celda
@@ -20,7 +36,47 @@ namespace Core {
 enum class CellState : uint8_t {
     DEAD = 0,   // Vacío/muerto
     ALIVE = 1,  // Vivo/activo
-    COUNT       // Número de estados
+    COUNT       // Número de estados (reglas de dos estados)
+    // Con reglas Generations los valores 2..C-1 son estados refractarios (muriendo)
+};
+
+/**
+ * @enum GridLayout
+ * @brief Representación en memoria de las celdas
+ */
+enum class GridLayout : uint8_t {
+    BYTES,  // Un CellState (byte) por celda
+    BITS,   // 64 celdas por palabra uint64_t (bit x%64 de la palabra x/64), un plano por bit del estado
+    TILED   // Como BITS, pero en tiles de TILE_SIZE filas de una palabra guardados en orden de Morton
+};
+
+/**
+ * @enum BoundaryMode
+ * @brief Qué hay más allá del borde de la grilla
+ */
+enum class BoundaryMode : uint8_t {
+    DEAD,    // Celdas muertas
+    TORUS,   // El borde opuesto (x = -1 es x = width-1)
+    MIRROR,  // Reflejo incluyendo el borde (x = -1 es x = 0)
+    COUNT
+};
+
+/**
+ * @struct StepCounts
+ * @brief Contadores de una generación, producidos por los kernels durante el paso
+ */
+struct StepCounts {
+    int64_t births = 0;   // Celdas que pasaron a ALIVE
+    int64_t deaths = 0;   // Celdas que dejaron de estar ALIVE
+    int64_t changed = 0;  // Celdas con otro estado (incluye los estados refractarios)
+
+    StepCounts& operator+=(const StepCounts& other)
+    {
+        births += other.births;
+        deaths += other.deaths;
+        changed += other.changed;
+        return *this;
+    }
 };
 
 /**
@@ -29,12 +85,19 @@ enum class CellState : uint8_t {
  */
 class Grid2D {
 public:
+    // Lado de los tiles usados para rastrear regiones con cambios
+    static constexpr int TILE_SIZE = 64;
+
+    // Máximo número de estados por celda (reglas Generations)
+    static constexpr int MAX_STATES = 256;
+
     /**
      * @brief Constructor
      * @param width Ancho de la grilla
      * @param height Alto de la grilla
+     * @param layout Representación en memoria de las celdas
      */
-    Grid2D(int width, int height);
+    Grid2D(int width, int height, GridLayout layout = GridLayout::BYTES);
 
     /**
      * @brief Obtiene el estado de una celda
@@ -64,38 +127,349 @@ public:
      */
     int getHeight() const { return height; }
 
+    /**
+     * @brief Obtiene la representación en memoria de la grilla
+     * @return Layout de las celdas
+     */
+    GridLayout getLayout() const { return layout; }
+
+    /**
+     * @brief Ajusta el número de estados por celda
+     *
+     * En los layouts BITS y TILED cada fila pasa a tener ceil(log2(states)) planos. Las
+     * celdas con estados fuera de rango pasan a DEAD.
+     *
+     * @param states Número de estados (2 a MAX_STATES)
+     */
+    void setStateCount(int states);
+
+    /**
+     * @brief Establece el modo de borde
+     * @param mode Modo (marca todos los tiles como cambiados)
+     */
+    void setBoundary(BoundaryMode mode);
+
+    /**
+     * @brief Obtiene el modo de borde
+     * @return Modo actual
+     */
+    BoundaryMode getBoundary() const { return boundary; }
+
+    /**
+     * @brief Obtiene el nombre de un modo de borde
+     * @param mode Modo
+     * @return Nombre legible
+     */
+    static const char* getBoundaryName(BoundaryMode mode);
+
+    /**
+     * @brief Lleva una coordenada fuera de rango a la celda equivalente
+     * @param v Coordenada (cualquier valor)
+     * @param size Tamaño de la dimensión
+     * @param mode Modo de borde
+     * @return Coordenada en [0, size), o -1 si cae en el borde muerto
+     */
+    static int wrapCoordinate(int v, int size, BoundaryMode mode);
+
+    /**
+     * @brief Rellena las celdas fantasma a partir del contenido y el modo de borde
+     *
+     * Debe llamarse una vez por generación, antes de leer filas con getBitRow
+     * o getByteRow fuera de [0, width) x [0, height).
+     */
+    void refreshHalo();
+
+    /**
+     * @brief Obtiene el número de estados por celda
+     * @return Estados (2 para reglas de vida/muerte)
+     */
+    int getStateCount() const { return stateCount; }
+
+    /**
+     * @brief Obtiene el número de planos de bits por fila (layouts BITS y TILED)
+     * @return Planos (1 con dos estados)
+     */
+    int getPlaneCount() const { return planeCount; }
+
+    /**
+     * @brief Obtiene el número de palabras de 64 bits por fila (layouts BITS y TILED)
+     * @return Palabras por fila
+     */
+    int getWordsPerRow() const { return wordsPerRow; }
+
+    /**
+     * @brief Palabras que ocupa cada plano de una fila, halo incluido (layout BITS)
+     * @return wordsPerRow + 2
+     */
+    int getBitStride() const { return bitStride; }
+
+    /**
+     * @brief Máscara de bits válidos de la última palabra de cada fila
+     * @return Máscara (los bits de relleno a 0)
+     */
+    uint64_t getLastWordMask() const { return lastWordMask; }
+
+    /**
+     * @brief Posición de una fila empaquetada dentro de getBitData() (layout BITS)
+     *
+     * Cada fila ocupa bitStride palabras por plano: la palabra -1 lleva la
+     * celda fantasma izquierda en el bit 63 y la derecha está en el primer bit
+     * de relleno (o en la palabra wordsPerRow si width es múltiplo de 64).
+     *
+     * @param y Fila (-1 y height son las filas fantasma)
+     * @param plane Plano (0 = bit menos significativo del estado)
+     * @return Índice de la palabra 0 de la fila
+     */
+    size_t getBitOffset(int y, int plane = 0) const
+    {
+        return (static_cast<size_t>(y + 1) * planeCount + plane) * bitStride + 1;
+    }
+
+    /**
+     * @brief Acceso directo a una fila empaquetada (layout BITS)
+     *
+     * Los planos de cada fila son consecutivos: el bit p del estado de la
+     * celda x está en getBitRow(y, p)[x / 64].
+     *
+     * @param y Fila (-1 a height)
+     * @param plane Plano (0 = bit menos significativo del estado)
+     * @return Puntero a las palabras de la fila
+     */
+    const uint64_t* getBitRow(int y, int plane = 0) const { return bits.data() + getBitOffset(y, plane); }
+
+    /**
+     * @brief Contenido empaquetado completo, con halo (layout BITS)
+     * @return Buffer del que getBitOffset da las posiciones
+     */
+    const std::vector<uint64_t>& getBitData() const { return bits; }
+
+    /**
+     * @brief Posición de un tile dentro de getBitData() (layout TILED)
+     *
+     * Cada plano de un tile son TILE_SIZE palabras consecutivas, una por fila.
+     * En un tile parcial del borde la fila height y el primer bit de relleno
+     * son las celdas fantasma; los tiles -1 y tilesX/tilesY son el anillo de halo.
+     *
+     * @param tx Columna de tiles (-1 a tilesX)
+     * @param ty Fila de tiles (-1 a tilesY)
+     * @param plane Plano (0 = bit menos significativo del estado)
+     * @return Índice de la palabra de la fila 0 del tile
+     */
+    size_t getTileOffset(int tx, int ty, int plane = 0) const
+    {
+        size_t slot = static_cast<size_t>(ty + 1) * (tilesX + 2) + (tx + 1);
+        return tileSlots[slot] + static_cast<size_t>(plane) * TILE_SIZE;
+    }
+
+    /**
+     * @brief Acceso directo a las filas de un tile (layout TILED)
+     * @param tx Columna de tiles (-1 a tilesX)
+     * @param ty Fila de tiles (-1 a tilesY)
+     * @param plane Plano
+     * @return Puntero a las TILE_SIZE palabras del tile
+     */
+    const uint64_t* getTile(int tx, int ty, int plane = 0) const { return bits.data() + getTileOffset(tx, ty, plane); }
+
+    /**
+     * @brief Palabra de 64 celdas de una fila en cualquiera de los layouts empaquetados
+     * @param w Palabra (-1 a wordsPerRow)
+     * @param y Fila (-1 a height)
+     * @param plane Plano
+     * @return Palabra (celdas x = 64 * w + bit)
+     */
+    uint64_t getBitWord(int w, int y, int plane = 0) const { return bits[getWordIndex(w, y, plane)]; }
+
+    /**
+     * @brief Contador que cambia con cada modificación del contenido
+     * @return Revisión actual (sirve para detectar ediciones externas)
+     */
+    uint64_t getRevision() const { return revision; }
+
+    /**
+     * @brief Obtiene el número de tiles en X
+     * @return Columnas de tiles
+     */
+    int getTilesX() const { return tilesX; }
+
+    /**
+     * @brief Obtiene el número de tiles en Y
+     * @return Filas de tiles
+     */
+    int getTilesY() const { return tilesY; }
+
+    /**
+     * @brief Verifica si un tile cambió en la última generación (o fue editado)
+     * @param tx Columna del tile
+     * @param ty Fila del tile
+     * @return true si cambió
+     */
+    bool isTileChanged(int tx, int ty) const { return tileChanged[static_cast<size_t>(ty) * tilesX + tx] != 0; }
+
+    /**
+     * @brief Reemplaza los bits de cambio por tile (tras un paso)
+     * @param next tilesX*tilesY flags (recibe los anteriores)
+     */
+    void swapTileChanges(std::vector<uint8_t>& next);
+
+    /**
+     * @brief Marca todos los tiles como cambiados (fuerza un paso completo)
+     */
+    void markAllTilesChanged();
+
+    /**
+     * @brief Bytes que ocupa cada fila, halo incluido (layout BYTES)
+     * @return Distancia entre dos filas de getByteData()
+     */
+    int getByteStride() const { return byteStride; }
+
+    /**
+     * @brief Posición de una fila de bytes dentro de getByteData() (layout BYTES)
+     * @param y Fila (-1 y height son las filas fantasma)
+     * @return Índice de la celda 0 de la fila (la -1 y la width son fantasma)
+     */
+    size_t getByteOffset(int y) const { return static_cast<size_t>(y + 1) * byteStride + 1; }
+
+    /**
+     * @brief Acceso directo a una fila de bytes (layout BYTES)
+     * @param y Fila (-1 a height)
+     * @return Puntero a los width estados de la fila
+     */
+    const CellState* getByteRow(int y) const { return cells.data() + getByteOffset(y); }
+
+    /**
+     * @brief Contenido de bytes completo, con halo (layout BYTES)
+     * @return Buffer del que getByteOffset da las posiciones
+     */
+    const std::vector<CellState>& getByteData() const { return cells; }
+
+    /**
+     * @brief Buffer trasero de bytes, con la forma de getByteData() (layout BYTES)
+     *
+     * Tras un paso con tiles activos, los tiles no recalculados del buffer
+     * trasero ya coinciden con el frontal: no cambiaron en la generación
+     * anterior, que es justo lo que contiene el buffer trasero.
+     *
+     * @return Puntero escribible al buffer trasero
+     */
+    CellState* getBackByteData() { return backCells.data(); }
+
+    /**
+     * @brief Buffer trasero empaquetado, con la forma de getBitData() (layouts BITS y TILED)
+     * @return Puntero escribible al buffer trasero
+     */
+    uint64_t* getBackBitData() { return backBits.data(); }
+
+    /**
+     * @brief Publica el buffer trasero como frontal (intercambio de punteros, O(1))
+     * @param step Contadores de la generación calculada (actualizan la población)
+     */
+    void swapBuffers(const StepCounts& step);
+
+    /**
+     * @brief Obtiene las celdas vivas (estado 1)
+     *
+     * Se mantiene al editar y al publicar cada paso: no recorre la grilla.
+     *
+     * @return Población
+     */
+    int64_t getPopulation() const { return population; }
+
+    /**
+     * @brief Obtiene los contadores de la última generación
+     * @return Nacimientos, muertes y celdas cambiadas
+     */
+    const StepCounts& getLastStep() const { return lastStep; }
+
+    /**
+     * @brief Registra los contadores de un paso que no pasó por swapBuffers()
+     *
+     * Para motores que escriben con writeStates() o setCell() (Larger than
+     * Life, HashLife, universo disperso). No modifica la población.
+     *
+     * @param step Contadores de la generación
+     */
+    void setLastStep(const StepCounts& step) { lastStep = step; }
+
+    /**
+     * @brief Copia el estado de todas las celdas, independiente del layout
+     * @param out Recibe width*height estados (fila a fila)
+     */
+    void readStates(std::vector<CellState>& out) const;
+
+    /**
+     * @brief Reemplaza el estado de todas las celdas (marca todos los tiles y recuenta la población)
+     * @param states width*height estados (fila a fila)
+     */
+    void writeStates(const std::vector<CellState>& states);
+
     /**
      * @brief Limpia la grilla (todas las celdas a DEAD)
      */
     void clear();
 
     /**
-     * @brief Llena la grilla aleatoriamente
+     * @brief Llena la grilla aleatoriamente con una semilla nueva
      * @param probability Probabilidad de celda viva (0.0 a 1.0)
      */
     void randomize(float probability = 0.3f);
 
     /**
-     * @brief Cuenta vecinos vivos de una celda (vecindario de Moore - 8
-     * vecinos)
-     * @param x Coordenada X
-     * @param y Coordenada Y
-     * @return Número de vecinos vivos
+     * @brief Llena la grilla aleatoriamente de forma reproducible
+     *
+     * Cada palabra de 64 celdas es un Random::bernoulliWord con contador
+     * y * wordsPerRow + w: la misma semilla da la misma grilla en todos los
+     * layouts y con cualquier número de hilos.
+     *
+     * @param probability Probabilidad de celda viva (0.0 a 1.0)
+     * @param seed Semilla
+     * @param pool Hilos entre los que repartir las filas (nullptr = en serie)
      */
-    int countAliveNeighbors(int x, int y) const;
+    void randomize(float probability, uint64_t seed, ThreadPool* pool = nullptr);
 
     /**
-     * @brief Calcula el color de una celda basado en vecinos
+     * @brief Cuenta vecinos vivos de una celda (vecindario de Moore - 8
+     * vecinos, según el modo de borde)
      * @param x Coordenada X
      * @param y Coordenada Y
-     * @return Color RGB (0.0 a 1.0)
+     * @return Número de vecinos vivos
      */
-    void getCellColor(int x, int y, float& r, float& g, float& b) const;
+    int countAliveNeighbors(int x, int y) const;
 
 private:
     int width;
     int height;
+    GridLayout layout;
+    BoundaryMode boundary;
+    int stateCount;
+
+    // Layout BYTES: (height+2) filas de byteStride = width+2 celdas (halo incluido)
+    int byteStride;
     std::vector<CellState> cells;
+    std::vector<CellState> backCells;
+
+    // Layout BITS: (height+2) filas de planeCount planos de bitStride = wordsPerRow+2 palabras.
+    // Los bits de relleno están a 0 salvo el primero, que es la celda fantasma derecha
+    int planeCount;
+    int wordsPerRow;
+    int bitStride;
+    uint64_t lastWordMask;
+    std::vector<uint64_t> bits;
+    std::vector<uint64_t> backBits;
+
+    // Layout TILED: palabra inicial de cada tile, anillo de halo incluido ((tilesY+2) x (tilesX+2)).
+    // Los tiles interiores van primero en orden de Morton y el anillo detrás
+    std::vector<size_t> tileSlots;
+
+    // Un flag por tile de TILE_SIZE x TILE_SIZE: cambió en la última generación
+    int tilesX;
+    int tilesY;
+    std::vector<uint8_t> tileChanged;
+
+    uint64_t revision;
+
+    // Celdas vivas en el buffer frontal y contadores de la última generación
+    int64_t population;
+    StepCounts lastStep;
 
     /**
      * @brief Convierte coordenadas 2D a índice 1D
@@ -103,7 +477,28 @@ private:
      * @param y Coordenada Y
      * @return Índice en el vector
      */
-    int getIndex(int x, int y) const;
+    size_t getIndex(int x, int y) const;
+
+    /**
+     * @brief Índice de una palabra empaquetada (layouts BITS y TILED)
+     * @param w Palabra (-1 a wordsPerRow)
+     * @param y Fila (-1 a height)
+     * @param plane Plano
+     * @return Índice en bits
+     */
+    size_t getWordIndex(int w, int y, int plane) const
+    {
+        if (layout == GridLayout::BITS)
+            return getBitOffset(y, plane) + w;
+        // División hacia abajo: la fila -1 es la última del tile -1
+        int ty = (y + TILE_SIZE) / TILE_SIZE - 1;
+        return getTileOffset(w, ty, plane) + (y - ty * TILE_SIZE);
+    }
+
+    /**
+     * @brief Reserva los dos buffers (con halo) del layout actual
+     */
+    void allocate();
 
     /**
      * @brief Verifica si las coordenadas están dentro de los límites
@@ -0,0 +1,236 @@
+/**
+ * @file Grid3D.cpp
+ * @brief Implementación de Grid3D
+ */
+
+#include "Grid3D.hpp"
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <bit>
+#include <random>
+
+namespace Core {
+
+Grid3D::Grid3D(int width, int height, int depth) :
+    width(width), height(height), depth(depth), boundary(BoundaryMode::DEAD), stateCount(2), planeCount(1),
+    wordsPerRow((width + 63) / 64), bitStride(wordsPerRow + 2),
+    lastWordMask(width % 64 == 0 ? ~0ULL : (1ULL << (width % 64)) - 1), revision(0), population(0)
+{
+    allocate();
+}
+
+void Grid3D::allocate()
+{
+    bits.assign(static_cast<size_t>(depth + 2) * (height + 2) * planeCount * bitStride, 0);
+    backBits.assign(bits.size(), 0);
+}
+
+bool Grid3D::isValid(int x, int y, int z) const
+{
+    return x >= 0 && x < width && y >= 0 && y < height && z >= 0 && z < depth;
+}
+
+CellState Grid3D::getCell(int x, int y, int z) const
+{
+    if (!isValid(x, y, z))
+        return CellState::DEAD;
+    int state = 0;
+    for (int p = 0; p < planeCount; ++p)
+        state |= static_cast<int>((getBitRow(y, z, p)[x >> 6] >> (x & 63)) & 1) << p;
+    return static_cast<CellState>(state);
+}
+
+void Grid3D::setCell(int x, int y, int z, CellState state)
+{
+    if (!isValid(x, y, z))
+        return;
+    revision++;
+    if (static_cast<int>(state) >= stateCount)
+        state = CellState::DEAD;
+    uint64_t mask = 1ULL << (x & 63);
+    int old = 0;
+    for (int p = 0; p < planeCount; ++p) {
+        uint64_t& word = bits[getBitOffset(y, z, p) + (x >> 6)];
+        old |= static_cast<int>((word >> (x & 63)) & 1) << p;
+        word = ((static_cast<int>(state) >> p) & 1) ? (word | mask) : (word & ~mask);
+    }
+    population += (state == CellState::ALIVE) - (old == 1);
+}
+
+void Grid3D::setStateCount(int states)
+{
+    states = std::clamp(states, 2, Grid2D::MAX_STATES);
+    if (states == stateCount)
+        return;
+
+    // Estados que dejan de existir pasan a DEAD
+    if (states < stateCount) {
+        for (int z = 0; z < depth; ++z) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    if (static_cast<int>(getCell(x, y, z)) >= states)
+                        setCell(x, y, z, CellState::DEAD);
+                }
+            }
+        }
+    }
+    stateCount = states;
+
+    int planes = 1;
+    while ((1 << planes) < states)
+        planes++;
+
+    if (planes != planeCount) {
+        // Reempaquetar con el nuevo número de planos (los planos altos de los estados válidos son 0)
+        std::vector<uint64_t> packed(static_cast<size_t>(depth + 2) * (height + 2) * planes * bitStride, 0);
+        int kept = std::min(planes, planeCount);
+        for (int z = 0; z < depth; ++z) {
+            for (int y = 0; y < height; ++y) {
+                size_t row = static_cast<size_t>(z + 1) * (height + 2) + (y + 1);
+                for (int p = 0; p < kept; ++p)
+                    std::copy_n(getBitRow(y, z, p), wordsPerRow, packed.begin() + (row * planes + p) * bitStride + 1);
+            }
+        }
+        bits.swap(packed);
+        backBits.assign(bits.size(), 0);
+        planeCount = planes;
+    }
+    revision++;
+}
+
+void Grid3D::setBoundary(BoundaryMode mode)
+{
+    if (mode == BoundaryMode::COUNT || mode == boundary)
+        return;
+    boundary = mode;
+    revision++;
+}
+
+void Grid3D::refreshHalo()
+{
+    // Fila/capa/columna de origen de cada lado fantasma (-1 = muerta)
+    const int top = Grid2D::wrapCoordinate(-1, height, boundary);
+    const int bottom = Grid2D::wrapCoordinate(height, height, boundary);
+    const int front = Grid2D::wrapCoordinate(-1, depth, boundary);
+    const int back = Grid2D::wrapCoordinate(depth, depth, boundary);
+    const int left = Grid2D::wrapCoordinate(-1, width, boundary);
+    const int right = Grid2D::wrapCoordinate(width, width, boundary);
+    const int tailBit = width % 64;
+
+    // 1. Columnas fantasma de las filas interiores
+    for (int z = 0; z < depth; ++z) {
+        for (int y = 0; y < height; ++y) {
+            for (int p = 0; p < planeCount; ++p) {
+                uint64_t* row = bits.data() + getBitOffset(y, z, p);
+                auto cell = [&](int x) -> uint64_t { return x < 0 ? 0 : (row[x >> 6] >> (x & 63)) & 1; };
+                uint64_t leftCell = cell(left);
+                uint64_t rightCell = cell(right);
+
+                // Izquierda: bit 63 de la palabra -1. Derecha: primer bit de relleno o palabra wordsPerRow
+                row[-1] = leftCell << 63;
+                if (tailBit != 0) {
+                    row[wordsPerRow - 1] = (row[wordsPerRow - 1] & lastWordMask) | (rightCell << tailBit);
+                    row[wordsPerRow] = 0;
+                } else {
+                    row[wordsPerRow] = rightCell;
+                }
+            }
+        }
+    }
+
+    // 2. Filas fantasma de cada capa interior (todos los planos, columnas fantasma incluidas)
+    const size_t rowWords = static_cast<size_t>(planeCount) * bitStride;
+    auto fillRows = [&](size_t ghost, size_t source, bool dead, size_t words) {
+        uint64_t* dst = bits.data() + ghost - 1;
+        if (dead) {
+            std::fill_n(dst, words, 0);
+        } else {
+            std::copy_n(bits.data() + source - 1, words, dst);
+        }
+    };
+    for (int z = 0; z < depth; ++z) {
+        fillRows(getBitOffset(-1, z), getBitOffset(std::max(top, 0), z), top < 0, rowWords);
+        fillRows(getBitOffset(height, z), getBitOffset(std::max(bottom, 0), z), bottom < 0, rowWords);
+    }
+
+    // 3. Capas fantasma completas (incluyen las filas fantasma, así las esquinas también se envuelven)
+    const size_t sliceWords = static_cast<size_t>(height + 2) * rowWords;
+    fillRows(getBitOffset(-1, -1), getBitOffset(-1, std::max(front, 0)), front < 0, sliceWords);
+    fillRows(getBitOffset(-1, depth), getBitOffset(-1, std::max(back, 0)), back < 0, sliceWords);
+}
+
+void Grid3D::swapBuffers(const StepCounts& step)
+{
+    bits.swap(backBits);
+    population += step.births - step.deaths;
+    lastStep = step;
+    revision++;
+}
+
+int64_t Grid3D::countPopulation() const
+{
+    int64_t population = 0;
+    for (int z = 0; z < depth; ++z) {
+        for (int y = 0; y < height; ++y) {
+            const uint64_t* row = getBitRow(y, z);
+            for (int w = 0; w < wordsPerRow; ++w) {
+                // Estado 1: plano 0 activo y el resto a 0. El relleno puede llevar la celda fantasma
+                uint64_t alive = row[w];
+                for (int p = 1; p < planeCount; ++p)
+                    alive &= ~row[static_cast<size_t>(p) * bitStride + w];
+                if (w == wordsPerRow - 1)
+                    alive &= lastWordMask;
+                population += std::popcount(alive);
+            }
+        }
+    }
+    return population;
+}
+
+void Grid3D::clear()
+{
+    std::fill(bits.begin(), bits.end(), 0);
+    population = 0;
+    revision++;
+}
+
+void Grid3D::randomize(float probability)
+{
+    static std::random_device rd;
+    randomize(probability, (static_cast<uint64_t>(rd()) << 32) | rd());
+}
+
+void Grid3D::randomize(float probability, uint64_t seed, ThreadPool* pool)
+{
+    const uint32_t threshold = Random::toThreshold(probability);
+    std::vector<int64_t> layerPopulation(depth, 0);
+
+    // Cada capa solo depende de sus contadores: las bandas se llenan en cualquier orden
+    auto fillLayers = [&](int begin, int end) {
+        for (int z = begin; z < end; ++z) {
+            int64_t count = 0;
+            for (int y = 0; y < height; ++y) {
+                const uint64_t row = static_cast<uint64_t>(z) * height + y;
+                for (int w = 0; w < wordsPerRow; ++w) {
+                    uint64_t word = Random::bernoulliWord(seed, row * wordsPerRow + w, threshold);
+                    if (w == wordsPerRow - 1)
+                        word &= lastWordMask;
+                    count += std::popcount(word);
+                    bits[getBitOffset(y, z, 0) + w] = word;
+                    for (int p = 1; p < planeCount; ++p)
+                        bits[getBitOffset(y, z, p) + w] = 0;
+                }
+            }
+            layerPopulation[z] = count;
+        }
+    };
+    ThreadPool::run(pool, depth, fillLayers);
+
+    population = 0;
+    for (int64_t count : layerPopulation)
+        population += count;
+    revision++;
+}
+
+}  // namespace Core
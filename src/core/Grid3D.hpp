@@ -0,0 +1,254 @@
+/**
+ * @file Grid3D.hpp
+ * @brief Grilla 3D empaquetada en bits para autómatas celulares
+ *
+ * Igual que el layout BITS de Grid2D, pero con filas indexadas por (y, z):
+ * 64 celdas por palabra, un plano por bit del estado y un halo de una celda
+ * en cada dirección que refreshHalo() rellena según el modo de borde.
+ *
+ * Hay dos buffers con la misma forma: el frontal (getCell, getBitRow, ...)
+ * es el que ven los lectores y el trasero es el destino del siguiente paso.
+ */
+
+#ifndef GRID3D_HPP
+#define GRID3D_HPP
+
+#include "Grid2D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class Grid3D
+ * @brief Volumen width x height x depth con estados discretos por celda
+ */
+class Grid3D {
+public:
+    /**
+     * @brief Constructor
+     * @param width Ancho (X)
+     * @param height Alto (Y)
+     * @param depth Profundidad (Z)
+     */
+    Grid3D(int width, int height, int depth);
+
+    /**
+     * @brief Obtiene el estado de una celda
+     * @param x Coordenada X
+     * @param y Coordenada Y
+     * @param z Coordenada Z
+     * @return Estado (DEAD fuera de la grilla)
+     */
+    CellState getCell(int x, int y, int z) const;
+
+    /**
+     * @brief Establece el estado de una celda
+     * @param x Coordenada X
+     * @param y Coordenada Y
+     * @param z Coordenada Z
+     * @param state Nuevo estado (los que no caben en getStateCount() pasan a DEAD)
+     */
+    void setCell(int x, int y, int z, CellState state);
+
+    /**
+     * @brief Obtiene el ancho
+     * @return Celdas en X
+     */
+    int getWidth() const { return width; }
+
+    /**
+     * @brief Obtiene el alto
+     * @return Celdas en Y
+     */
+    int getHeight() const { return height; }
+
+    /**
+     * @brief Obtiene la profundidad
+     * @return Celdas en Z
+     */
+    int getDepth() const { return depth; }
+
+    /**
+     * @brief Obtiene el número total de celdas
+     * @return width * height * depth
+     */
+    int64_t getCellCount() const { return static_cast<int64_t>(width) * height * depth; }
+
+    /**
+     * @brief Cambia el número de estados por celda (reempaqueta los planos)
+     *
+     * Las celdas con estados que dejan de existir pasan a DEAD.
+     *
+     * @param states Estados (2 a Grid2D::MAX_STATES)
+     */
+    void setStateCount(int states);
+
+    /**
+     * @brief Obtiene el número de estados por celda
+     * @return Estados (2 = vida/muerte)
+     */
+    int getStateCount() const { return stateCount; }
+
+    /**
+     * @brief Obtiene el número de planos de bits
+     * @return Planos (ceil(log2(estados)))
+     */
+    int getPlaneCount() const { return planeCount; }
+
+    /**
+     * @brief Establece qué hay más allá de las seis caras
+     * @param mode Celdas muertas, toro o espejo
+     */
+    void setBoundary(BoundaryMode mode);
+
+    /**
+     * @brief Obtiene el modo de borde
+     * @return Modo actual
+     */
+    BoundaryMode getBoundary() const { return boundary; }
+
+    /**
+     * @brief Rellena el halo del buffer frontal según el modo de borde
+     *
+     * Debe llamarse antes de cada paso; las ediciones no lo actualizan.
+     */
+    void refreshHalo();
+
+    /**
+     * @brief Obtiene las palabras de datos por fila
+     * @return ceil(width / 64)
+     */
+    int getWordsPerRow() const { return wordsPerRow; }
+
+    /**
+     * @brief Distancia en palabras entre planos consecutivos de una fila
+     * @return wordsPerRow + 2
+     */
+    int getBitStride() const { return bitStride; }
+
+    /**
+     * @brief Máscara de las celdas válidas de la última palabra
+     * @return Bits de datos de la palabra wordsPerRow-1
+     */
+    uint64_t getLastWordMask() const { return lastWordMask; }
+
+    /**
+     * @brief Posición de una fila empaquetada (mismo esquema de halo que Grid2D::getBitOffset)
+     * @param y Fila (-1 a height)
+     * @param z Capa (-1 a depth)
+     * @param plane Plano (0 = bit menos significativo del estado)
+     * @return Índice de la palabra 0 de la fila
+     */
+    size_t getBitOffset(int y, int z, int plane = 0) const
+    {
+        size_t row = static_cast<size_t>(z + 1) * (height + 2) + (y + 1);
+        return (row * planeCount + plane) * bitStride + 1;
+    }
+
+    /**
+     * @brief Acceso directo a una fila empaquetada del buffer frontal
+     * @param y Fila (-1 a height)
+     * @param z Capa (-1 a depth)
+     * @param plane Plano
+     * @return Puntero a las palabras de la fila
+     */
+    const uint64_t* getBitRow(int y, int z, int plane = 0) const { return bits.data() + getBitOffset(y, z, plane); }
+
+    /**
+     * @brief Buffer trasero, con la forma del frontal
+     * @return Puntero escribible al buffer trasero
+     */
+    uint64_t* getBackBitData() { return backBits.data(); }
+
+    /**
+     * @brief Publica el buffer trasero como frontal (intercambio de punteros, O(1))
+     * @param step Contadores de la generación calculada (actualizan la población)
+     */
+    void swapBuffers(const StepCounts& step);
+
+    /**
+     * @brief Obtiene las celdas vivas (estado 1), mantenidas al editar y en cada paso
+     * @return Población
+     */
+    int64_t getPopulation() const { return population; }
+
+    /**
+     * @brief Obtiene los contadores de la última generación
+     * @return Nacimientos, muertes y celdas cambiadas
+     */
+    const StepCounts& getLastStep() const { return lastStep; }
+
+    /**
+     * @brief Contador que aumenta con cada modificación
+     * @return Revisión actual
+     */
+    uint64_t getRevision() const { return revision; }
+
+    /**
+     * @brief Recuenta las celdas vivas (estado 1) con popcount por palabra
+     * @return Población (igual a getPopulation())
+     */
+    int64_t countPopulation() const;
+
+    /**
+     * @brief Limpia la grilla (todas las celdas muertas)
+     */
+    void clear();
+
+    /**
+     * @brief Inicializa con celdas vivas aleatorias
+     * @param probability Probabilidad de que una celda esté viva
+     */
+    void randomize(float probability = 0.3f);
+
+    /**
+     * @brief Llena el volumen aleatoriamente de forma reproducible
+     *
+     * Igual que Grid2D::randomize: cada palabra es un Random::bernoulliWord con
+     * contador (z * height + y) * wordsPerRow + w, así que la misma semilla da
+     * el mismo volumen con cualquier número de hilos.
+     *
+     * @param probability Probabilidad de celda viva (0.0 a 1.0)
+     * @param seed Semilla
+     * @param pool Hilos entre los que repartir las capas (nullptr = en serie)
+     */
+    void randomize(float probability, uint64_t seed, ThreadPool* pool = nullptr);
+
+private:
+    int width;
+    int height;
+    int depth;
+    BoundaryMode boundary;
+    int stateCount;
+
+    // (depth+2) capas de (height+2) filas de planeCount planos de bitStride = wordsPerRow+2 palabras
+    int planeCount;
+    int wordsPerRow;
+    int bitStride;
+    uint64_t lastWordMask;
+    std::vector<uint64_t> bits;
+    std::vector<uint64_t> backBits;
+
+    uint64_t revision;
+
+    // Celdas vivas en el buffer frontal y contadores de la última generación
+    int64_t population;
+    StepCounts lastStep;
+
+    /**
+     * @brief Reserva los dos buffers (con halo) para planeCount planos
+     */
+    void allocate();
+
+    /**
+     * @brief Verifica si las coordenadas están dentro de los límites
+     * @return true si están dentro
+     */
+    bool isValid(int x, int y, int z) const;
+};
+
+}  // namespace Core
+
+#endif  // GRID3D_HPP
@@ -0,0 +1,321 @@
+/**
+ * @file HashLife.cpp
+ * @brief Implementación del motor HashLife
+ */
+
+#include "HashLife.hpp"
+#include <algorithm>
+
+namespace Core {
+
+// Nivel máximo de la raíz: mantiene las coordenadas dentro de int64_t
+static const int MAX_STEP_LOG2 = 56;
+
+// Nivel que marca un hueco de la lista libre
+static const uint8_t FREE_LEVEL = 0xFF;
+
+HashLife::HashLife(size_t memoryLimit) :
+    root(NONE), stepLog2(0), memoryLimit(memoryLimit), birthMask(1u << 3), survivalMask((1u << 2) | (1u << 3))
+{
+    // Hojas: una celda muerta y una viva
+    nodes.push_back({ NONE, NONE, NONE, NONE, NONE, 0, false, 0 });
+    nodes.push_back({ NONE, NONE, NONE, NONE, NONE, 0, false, 1 });
+    root = emptyNode(3);
+}
+
+void HashLife::setRule(uint16_t birthMask, uint16_t survivalMask)
+{
+    if (birthMask == this->birthMask && survivalMask == this->survivalMask)
+        return;
+    this->birthMask = birthMask;
+    this->survivalMask = survivalMask;
+    clearResults();
+}
+
+void HashLife::setStepLog2(int k)
+{
+    k = std::clamp(k, 0, MAX_STEP_LOG2);
+    if (k == stepLog2)
+        return;
+    stepLog2 = k;
+    // RESULT depende del tamaño de paso: los resultados memoizados dejan de valer
+    clearResults();
+}
+
+void HashLife::step()
+{
+    if (getMemoryUsage() > memoryLimit)
+        collectGarbage();
+
+    // El patrón debe caber en el cuarto central para que el resultado sea exacto
+    while (rootLevel() < stepLog2 + 3 || nodes[centerOf(centerOf(root))].population != nodes[root].population) {
+        root = expand(root);
+    }
+    root = successor(root);
+}
+
+void HashLife::loadFromGrid(const Grid2D& grid)
+{
+    int level = 3;
+    while ((int64_t(1) << (level - 1)) < std::max(grid.getWidth(), grid.getHeight())) {
+        level++;
+    }
+    int64_t half = int64_t(1) << (level - 1);
+    root = build(grid, level, -half, -half);
+
+    if (getMemoryUsage() > memoryLimit)
+        collectGarbage();
+}
+
+void HashLife::storeToGrid(Grid2D& grid) const
+{
+    grid.clear();
+    int64_t half = int64_t(1) << (rootLevel() - 1);
+    store(grid, root, -half, -half);
+}
+
+size_t HashLife::getMemoryUsage() const
+{
+    // Aproximación: nodos vivos + sus entradas de la tabla (clave, valor, enlace y cubeta). Ni el vector ni
+    // la tabla se encogen al recolectar, pero sus huecos se reutilizan: contarlos dispararía la recolección
+    // en cada paso en cuanto el arena hubiera superado el límite una vez
+    size_t entrySize = sizeof(NodeKey) + sizeof(NodeId) + 3 * sizeof(void*);
+    return (nodes.size() - freeList.size()) * sizeof(Node) + table.size() * entrySize;
+}
+
+void HashLife::collectGarbage()
+{
+    for (auto& node : nodes) {
+        node.marked = false;
+    }
+
+    mark(DEAD_LEAF);
+    mark(ALIVE_LEAF);
+    mark(root);
+    for (NodeId empty : emptyNodes) {
+        if (empty != NONE)
+            mark(empty);
+    }
+
+    for (NodeId id = 2; id < nodes.size(); ++id) {
+        Node& node = nodes[id];
+        if (node.level == FREE_LEVEL)
+            continue;
+        if (!node.marked) {
+            table.erase(NodeKey{ node.nw, node.ne, node.sw, node.se });
+            node.level = FREE_LEVEL;
+            freeList.push_back(id);
+        }
+    }
+
+    // Un resultado liberado se recalculará si vuelve a hacer falta
+    for (auto& node : nodes) {
+        if (node.level != FREE_LEVEL && node.result != NONE && !nodes[node.result].marked) {
+            node.result = NONE;
+        }
+    }
+}
+
+HashLife::NodeId HashLife::join(NodeId nw, NodeId ne, NodeId sw, NodeId se)
+{
+    NodeKey key{ nw, ne, sw, se };
+    auto it = table.find(key);
+    if (it != table.end())
+        return it->second;
+
+    Node node{ nw,
+               ne,
+               sw,
+               se,
+               NONE,
+               static_cast<uint8_t>(nodes[nw].level + 1),
+               false,
+               nodes[nw].population + nodes[ne].population + nodes[sw].population + nodes[se].population };
+
+    NodeId id;
+    if (!freeList.empty()) {
+        id = freeList.back();
+        freeList.pop_back();
+        nodes[id] = node;
+    } else {
+        id = static_cast<NodeId>(nodes.size());
+        nodes.push_back(node);
+    }
+
+    table.emplace(key, id);
+    return id;
+}
+
+HashLife::NodeId HashLife::emptyNode(int level)
+{
+    if (level == 0)
+        return DEAD_LEAF;
+    if (static_cast<int>(emptyNodes.size()) <= level)
+        emptyNodes.resize(level + 1, NONE);
+    if (emptyNodes[level] == NONE) {
+        NodeId child = emptyNode(level - 1);
+        emptyNodes[level] = join(child, child, child, child);
+    }
+    return emptyNodes[level];
+}
+
+HashLife::NodeId HashLife::expand(NodeId node)
+{
+    Node n = nodes[node];
+    NodeId e = emptyNode(n.level - 1);
+    NodeId nw = join(e, e, e, n.nw);
+    NodeId ne = join(e, e, n.ne, e);
+    NodeId sw = join(e, n.sw, e, e);
+    NodeId se = join(n.se, e, e, e);
+    return join(nw, ne, sw, se);
+}
+
+HashLife::NodeId HashLife::centerOf(NodeId node)
+{
+    Node n = nodes[node];
+    return join(nodes[n.nw].se, nodes[n.ne].sw, nodes[n.sw].ne, nodes[n.se].nw);
+}
+
+HashLife::NodeId HashLife::successor(NodeId node)
+{
+    // Copia: join() puede reubicar el vector de nodos
+    Node n = nodes[node];
+    if (n.population == 0)
+        return emptyNode(n.level - 1);
+    if (n.result != NONE)
+        return n.result;
+
+    NodeId result;
+    if (n.level == 2) {
+        result = baseSuccessor(node);
+    } else {
+        // Nietos en una cuadrícula 4x4
+        NodeId g[4][4];
+        const NodeId children[2][2] = { { n.nw, n.ne }, { n.sw, n.se } };
+        for (int cy = 0; cy < 2; ++cy) {
+            for (int cx = 0; cx < 2; ++cx) {
+                const Node& child = nodes[children[cy][cx]];
+                g[cy * 2][cx * 2] = child.nw;
+                g[cy * 2][cx * 2 + 1] = child.ne;
+                g[cy * 2 + 1][cx * 2] = child.sw;
+                g[cy * 2 + 1][cx * 2 + 1] = child.se;
+            }
+        }
+
+        // Nueve subnodos solapados; la primera mitad avanza solo a velocidad completa
+        bool fullSpeed = stepLog2 >= n.level - 2;
+        NodeId half[3][3];
+        for (int y = 0; y < 3; ++y) {
+            for (int x = 0; x < 3; ++x) {
+                NodeId sub = join(g[y][x], g[y][x + 1], g[y + 1][x], g[y + 1][x + 1]);
+                half[y][x] = fullSpeed ? successor(sub) : centerOf(sub);
+            }
+        }
+
+        NodeId quad[2][2];
+        for (int y = 0; y < 2; ++y) {
+            for (int x = 0; x < 2; ++x) {
+                quad[y][x]
+                    = successor(join(half[y][x], half[y][x + 1], half[y + 1][x], half[y + 1][x + 1]));
+            }
+        }
+        result = join(quad[0][0], quad[0][1], quad[1][0], quad[1][1]);
+    }
+
+    nodes[node].result = result;
+    return result;
+}
+
+HashLife::NodeId HashLife::baseSuccessor(NodeId node)
+{
+    // Nodo de nivel 2: 4x4 celdas, se calcula el centro 2x2 una generación después
+    int cells[4][4];
+    Node n = nodes[node];
+    const NodeId children[2][2] = { { n.nw, n.ne }, { n.sw, n.se } };
+    for (int cy = 0; cy < 2; ++cy) {
+        for (int cx = 0; cx < 2; ++cx) {
+            const Node& child = nodes[children[cy][cx]];
+            cells[cy * 2][cx * 2] = child.nw == ALIVE_LEAF;
+            cells[cy * 2][cx * 2 + 1] = child.ne == ALIVE_LEAF;
+            cells[cy * 2 + 1][cx * 2] = child.sw == ALIVE_LEAF;
+            cells[cy * 2 + 1][cx * 2 + 1] = child.se == ALIVE_LEAF;
+        }
+    }
+
+    NodeId next[2][2];
+    for (int y = 1; y <= 2; ++y) {
+        for (int x = 1; x <= 2; ++x) {
+            int count = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx != 0 || dy != 0)
+                        count += cells[y + dy][x + dx];
+                }
+            }
+            uint16_t mask = cells[y][x] ? survivalMask : birthMask;
+            next[y - 1][x - 1] = ((mask >> count) & 1) ? ALIVE_LEAF : DEAD_LEAF;
+        }
+    }
+    return join(next[0][0], next[0][1], next[1][0], next[1][1]);
+}
+
+HashLife::NodeId HashLife::build(const Grid2D& grid, int level, int64_t x0, int64_t y0)
+{
+    int64_t size = int64_t(1) << level;
+    if (x0 >= grid.getWidth() || y0 >= grid.getHeight() || x0 + size <= 0 || y0 + size <= 0)
+        return emptyNode(level);
+
+    if (level == 0) {
+        bool alive = grid.getCell(static_cast<int>(x0), static_cast<int>(y0)) == CellState::ALIVE;
+        return alive ? ALIVE_LEAF : DEAD_LEAF;
+    }
+
+    int64_t half = size / 2;
+    NodeId nw = build(grid, level - 1, x0, y0);
+    NodeId ne = build(grid, level - 1, x0 + half, y0);
+    NodeId sw = build(grid, level - 1, x0, y0 + half);
+    NodeId se = build(grid, level - 1, x0 + half, y0 + half);
+    return join(nw, ne, sw, se);
+}
+
+void HashLife::store(Grid2D& grid, NodeId node, int64_t x0, int64_t y0) const
+{
+    const Node& n = nodes[node];
+    int64_t size = int64_t(1) << n.level;
+    if (n.population == 0 || x0 >= grid.getWidth() || y0 >= grid.getHeight() || x0 + size <= 0 || y0 + size <= 0)
+        return;
+
+    if (n.level == 0) {
+        grid.setCell(static_cast<int>(x0), static_cast<int>(y0), CellState::ALIVE);
+        return;
+    }
+
+    int64_t half = size / 2;
+    store(grid, n.nw, x0, y0);
+    store(grid, n.ne, x0 + half, y0);
+    store(grid, n.sw, x0, y0 + half);
+    store(grid, n.se, x0 + half, y0 + half);
+}
+
+void HashLife::mark(NodeId node)
+{
+    Node& n = nodes[node];
+    if (n.marked)
+        return;
+    n.marked = true;
+    if (n.level == 0)
+        return;
+    mark(n.nw);
+    mark(n.ne);
+    mark(n.sw);
+    mark(n.se);
+}
+
+void HashLife::clearResults()
+{
+    for (auto& node : nodes) {
+        node.result = NONE;
+    }
+}
+
+}  // namespace Core
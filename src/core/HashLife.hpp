@@ -0,0 +1,210 @@
+/**
+ * @file HashLife.hpp
+ * @brief Motor HashLife: quadtree con hash-consing y RESULT memoizado
+ *
+ * Permite avanzar 2^k generaciones por paso en patrones grandes y periódicos.
+ * El universo es un plano infinito; el Grid2D actúa como ventana sobre él.
+ */
+
+#ifndef HASHLIFE_HPP
+#define HASHLIFE_HPP
+
+#include "Grid2D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class HashLife
+ * @brief Algoritmo de Gosper para reglas totalísticas de dos estados
+ */
+class HashLife {
+public:
+    /**
+     * @brief Constructor
+     * @param memoryLimit Memoria máxima (bytes) antes de recolectar nodos
+     */
+    explicit HashLife(size_t memoryLimit = 256u * 1024u * 1024u);
+
+    /**
+     * @brief Verifica si una regla puede simularse con HashLife
+     * @param birthMask Máscara de nacimiento
+     * @return false si la regla tiene B0 (el vacío no sería estable)
+     */
+    static bool supportsRule(uint16_t birthMask) { return (birthMask & 1) == 0; }
+
+    /**
+     * @brief Establece la regla (invalida los resultados memoizados)
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     */
+    void setRule(uint16_t birthMask, uint16_t survivalMask);
+
+    /**
+     * @brief Establece cuántas generaciones avanza cada step() (2^k)
+     * @param k Exponente (0 = una generación)
+     */
+    void setStepLog2(int k);
+
+    /**
+     * @brief Obtiene el exponente del tamaño de paso
+     * @return k tal que cada step() avanza 2^k generaciones
+     */
+    int getStepLog2() const { return stepLog2; }
+
+    /**
+     * @brief Avanza 2^k generaciones
+     */
+    void step();
+
+    /**
+     * @brief Carga el contenido de un grid (celda (x, y) del grid = (x, y) del plano)
+     * @param grid Grid de origen
+     */
+    void loadFromGrid(const Grid2D& grid);
+
+    /**
+     * @brief Escribe en el grid la ventana [0, width) x [0, height) del plano
+     * @param grid Grid de destino (se recorta lo que queda fuera)
+     */
+    void storeToGrid(Grid2D& grid) const;
+
+    /**
+     * @brief Obtiene la población total del plano
+     * @return Células vivas
+     */
+    uint64_t getPopulation() const { return nodes[root].population; }
+
+    /**
+     * @brief Obtiene el número de nodos en la caché
+     * @return Nodos vivos
+     */
+    size_t getNodeCount() const { return table.size(); }
+
+    /**
+     * @brief Estima la memoria usada por los nodos vivos y la tabla hash
+     * @return Bytes (sin los huecos libres, que se reutilizan)
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Establece el límite de memoria de la caché de nodos
+     * @param bytes Límite en bytes (se comprueba entre pasos)
+     */
+    void setMemoryLimit(size_t bytes) { memoryLimit = bytes; }
+
+    /**
+     * @brief Libera los nodos inalcanzables desde la raíz
+     */
+    void collectGarbage();
+
+private:
+    using NodeId = uint32_t;
+    static constexpr NodeId NONE = 0xFFFFFFFFu;
+    static constexpr NodeId DEAD_LEAF = 0;
+    static constexpr NodeId ALIVE_LEAF = 1;
+
+    /**
+     * @struct Node
+     * @brief Nodo canónico: un cuadrado de 2^level x 2^level celdas
+     */
+    struct Node {
+        NodeId nw, ne, sw, se;  // Hijos (nivel - 1)
+        NodeId result;          // Centro tras 2^stepLog2 generaciones (o NONE)
+        uint8_t level;
+        bool marked;  // Marca de la recolección de basura
+        uint64_t population;
+    };
+
+    struct NodeKey {
+        NodeId nw, ne, sw, se;
+        bool operator==(const NodeKey& other) const
+        {
+            return nw == other.nw && ne == other.ne && sw == other.sw && se == other.se;
+        }
+    };
+
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey& key) const
+        {
+            uint64_t h = key.nw * 0x9E3779B97F4A7C15ULL;
+            h = (h ^ key.ne) * 0xC2B2AE3D27D4EB4FULL;
+            h = (h ^ key.sw) * 0x165667B19E3779F9ULL;
+            h = (h ^ key.se) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
+    };
+
+    std::vector<Node> nodes;
+    std::vector<NodeId> freeList;
+    std::unordered_map<NodeKey, NodeId, NodeKeyHash> table;
+    std::vector<NodeId> emptyNodes;  // Nodo vacío por nivel (o NONE)
+
+    NodeId root;  // Centrado en el origen: cubre [-2^(L-1), 2^(L-1))
+    int stepLog2;
+    size_t memoryLimit;
+    uint16_t birthMask;
+    uint16_t survivalMask;
+
+    /**
+     * @brief Obtiene (o crea) el nodo canónico con esos cuatro hijos
+     */
+    NodeId join(NodeId nw, NodeId ne, NodeId sw, NodeId se);
+
+    /**
+     * @brief Obtiene el nodo vacío de un nivel
+     */
+    NodeId emptyNode(int level);
+
+    /**
+     * @brief Duplica el tamaño de la raíz manteniendo el contenido centrado
+     */
+    NodeId expand(NodeId node);
+
+    /**
+     * @brief Subnodo central (nivel - 1) de un nodo
+     */
+    NodeId centerOf(NodeId node);
+
+    /**
+     * @brief Centro del nodo avanzado 2^stepLog2 generaciones (nivel - 1)
+     */
+    NodeId successor(NodeId node);
+
+    /**
+     * @brief Caso base: nodo 4x4 -> centro 2x2 tras una generación
+     */
+    NodeId baseSuccessor(NodeId node);
+
+    /**
+     * @brief Construye el nodo que cubre [x0, x0 + 2^level) x [y0, y0 + 2^level) del grid
+     */
+    NodeId build(const Grid2D& grid, int level, int64_t x0, int64_t y0);
+
+    /**
+     * @brief Escribe las celdas vivas de un nodo en el grid
+     */
+    void store(Grid2D& grid, NodeId node, int64_t x0, int64_t y0) const;
+
+    /**
+     * @brief Marca recursivamente los nodos alcanzables
+     */
+    void mark(NodeId node);
+
+    /**
+     * @brief Olvida todos los resultados memoizados
+     */
+    void clearResults();
+
+    /**
+     * @brief Nivel de la raíz
+     */
+    int rootLevel() const { return nodes[root].level; }
+};
+
+}  // namespace Core
+
+#endif  // HASHLIFE_HPP
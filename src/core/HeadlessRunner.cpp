@@ -0,0 +1,452 @@
+/**
+ * @file HeadlessRunner.cpp
+ * @brief Implementación de HeadlessRunner
+ */
+
+#include "HeadlessRunner.hpp"
+#include "Simulator.hpp"
+#include "Simulator3D.hpp"
+#include "Stats.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace Core {
+
+namespace {
+
+// Longitud máxima de las líneas del RLE (la del formato de Golly)
+const int RLE_LINE_LENGTH = 70;
+
+// Opciones que van seguidas de un valor
+const char* const VALUE_OPTIONS[] = {
+    "--rule", "--size", "--gens", "--seed", "--density", "--layout", "--boundary",
+    "--threads", "--steps-per-pass", "--stats-every", "--stats", "--out",
+};
+
+/**
+ * @brief Interpreta un entero de la línea de comandos
+ * @param option Nombre de la opción (para el mensaje de error)
+ * @param text Valor
+ * @param minimum Menor valor admitido
+ * @return Valor
+ */
+int64_t parseInteger(const std::string& option, const std::string& text, int64_t minimum)
+{
+    int64_t value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size() || value < minimum)
+        throw std::invalid_argument(option + ": expected an integer >= " + std::to_string(minimum) + ", got '" +
+                                    text + "'");
+    return value;
+}
+
+/**
+ * @brief Escribe el grid en formato RLE (el de Golly y LifeWiki)
+ *
+ * Dos estados usan b/o; con más, '.' es la celda muerta y A, B, ... los
+ * estados 1, 2, ... (pA, pB, ... a partir del 25). Un volumen se escribe
+ * capa a capa separadas por '/', como el RLE 3D de Golly.
+ */
+class RleWriter {
+public:
+    RleWriter(std::ostream& out, int states) : out(out), states(states), lineLength(0) { }
+
+    void write(const Grid2D& grid)
+    {
+        writeLayer(grid.getWidth(), grid.getHeight(), [&](int x, int y) { return grid.getCell(x, y); });
+        emit(1, "!");
+        out << '\n';
+    }
+
+    void write(const Grid3D& grid)
+    {
+        int pendingLayers = 0;
+        for (int z = 0; z < grid.getDepth(); ++z) {
+            if (z > 0)
+                pendingLayers++;
+            bool empty = true;
+            for (int y = 0; y < grid.getHeight() && empty; ++y) {
+                for (int x = 0; x < grid.getWidth() && empty; ++x)
+                    empty = grid.getCell(x, y, z) == CellState::DEAD;
+            }
+            if (empty)
+                continue;
+            if (pendingLayers > 0) {
+                emit(pendingLayers, "/");
+                pendingLayers = 0;
+            }
+            writeLayer(grid.getWidth(), grid.getHeight(), [&](int x, int y) { return grid.getCell(x, y, z); });
+        }
+        emit(1, "!");
+        out << '\n';
+    }
+
+private:
+    std::ostream& out;
+    int states;
+    int lineLength;
+
+    void writeLayer(int width, int height, const std::function<CellState(int x, int y)>& cellAt)
+    {
+        int pendingRows = 0;
+        std::vector<CellState> row(width);
+        for (int y = 0; y < height; ++y) {
+            if (y > 0)
+                pendingRows++;
+            for (int x = 0; x < width; ++x)
+                row[x] = cellAt(x, y);
+
+            // Las celdas muertas del final de la fila no se escriben
+            int end = width;
+            while (end > 0 && row[end - 1] == CellState::DEAD)
+                end--;
+            if (end == 0)
+                continue;
+            if (pendingRows > 0) {
+                emit(pendingRows, "$");
+                pendingRows = 0;
+            }
+            for (int x = 0; x < end;) {
+                int run = 1;
+                while (x + run < end && row[x + run] == row[x])
+                    run++;
+                emit(run, token(row[x]));
+                x += run;
+            }
+        }
+    }
+
+    std::string token(CellState state) const
+    {
+        int value = static_cast<int>(state);
+        if (states == 2)
+            return value == 0 ? "b" : "o";
+        if (value == 0)
+            return ".";
+        std::string text;
+        if ((value - 1) / 24 > 0)
+            text += static_cast<char>('p' + (value - 1) / 24 - 1);
+        text += static_cast<char>('A' + (value - 1) % 24);
+        return text;
+    }
+
+    void emit(int count, const std::string& symbol)
+    {
+        std::string item = count > 1 ? std::to_string(count) + symbol : symbol;
+        if (lineLength + static_cast<int>(item.size()) > RLE_LINE_LENGTH) {
+            out << '\n';
+            lineLength = 0;
+        }
+        out << item;
+        lineLength += static_cast<int>(item.size());
+    }
+};
+
+}  // namespace
+
+bool HeadlessRunner::hasFlag(int argc, char* argv[], const char* flag)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], flag) == 0)
+            return true;
+    }
+    return false;
+}
+
+HeadlessOptions HeadlessRunner::parseArguments(int argc, char* argv[])
+{
+    HeadlessOptions options;
+    std::string ruleNotation;  // Se interpreta al final: la notación depende de si --size tiene profundidad
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option == "--headless" || option == "--help")
+            continue;
+        // Una opción desconocida no consume el argumento siguiente
+        if (std::find(std::begin(VALUE_OPTIONS), std::end(VALUE_OPTIONS), option) == std::end(VALUE_OPTIONS))
+            throw std::invalid_argument("unknown option '" + option + "'");
+        if (i + 1 >= argc)
+            throw std::invalid_argument(option + ": missing value");
+        const std::string value = argv[++i];
+
+        if (option == "--rule") {
+            ruleNotation = value;
+        } else if (option == "--size") {
+            std::vector<std::string> fields;
+            for (size_t begin = 0;;) {
+                size_t separator = value.find('x', begin);
+                fields.push_back(value.substr(begin, separator - begin));
+                if (separator == std::string::npos)
+                    break;
+                begin = separator + 1;
+            }
+            if (fields.size() != 2 && fields.size() != 3)
+                throw std::invalid_argument("--size: expected WIDTHxHEIGHT or WIDTHxHEIGHTxDEPTH, got '" + value + "'");
+            options.width = static_cast<int>(std::min<int64_t>(parseInteger(option, fields[0], 1), INT32_MAX));
+            options.height = static_cast<int>(std::min<int64_t>(parseInteger(option, fields[1], 1), INT32_MAX));
+            options.depth = fields.size() == 3
+                                ? static_cast<int>(std::min<int64_t>(parseInteger(option, fields[2], 1), INT32_MAX))
+                                : 0;
+        } else if (option == "--gens") {
+            options.generations = parseInteger(option, value, 0);
+        } else if (option == "--seed") {
+            options.seed = static_cast<uint64_t>(parseInteger(option, value, 0));
+            options.randomSeed = false;
+        } else if (option == "--density") {
+            float density = -1.0f;
+            auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), density);
+            if (error != std::errc() || end != value.data() + value.size() || density < 0.0f || density > 1.0f)
+                throw std::invalid_argument("--density: expected a probability from 0 to 1, got '" + value + "'");
+            options.density = density;
+        } else if (option == "--layout") {
+            if (value == "bytes") {
+                options.layout = GridLayout::BYTES;
+            } else if (value == "bits") {
+                options.layout = GridLayout::BITS;
+            } else if (value == "tiled") {
+                options.layout = GridLayout::TILED;
+            } else {
+                throw std::invalid_argument("--layout: expected bytes, bits or tiled, got '" + value + "'");
+            }
+        } else if (option == "--boundary") {
+            if (value == "dead") {
+                options.boundary = BoundaryMode::DEAD;
+            } else if (value == "torus") {
+                options.boundary = BoundaryMode::TORUS;
+            } else if (value == "mirror") {
+                options.boundary = BoundaryMode::MIRROR;
+            } else {
+                throw std::invalid_argument("--boundary: expected dead, torus or mirror, got '" + value + "'");
+            }
+        } else if (option == "--threads") {
+            options.threadCount = static_cast<int>(std::min<int64_t>(parseInteger(option, value, 0), 1024));
+        } else if (option == "--steps-per-pass") {
+            options.stepsPerPass =
+                static_cast<int>(std::min<int64_t>(parseInteger(option, value, 1), Simulator::MAX_STEPS_PER_PASS));
+        } else if (option == "--stats-every") {
+            options.statsInterval = parseInteger(option, value, 1);
+        } else if (option == "--stats") {
+            options.statsPath = value;
+        } else if (option == "--out") {
+            options.statePath = value;
+        }
+    }
+
+    if (!ruleNotation.empty() && options.depth > 0) {
+        std::optional<Rule3D> rule = Rules3D::parse(ruleNotation);
+        if (!rule)
+            throw std::invalid_argument("--rule: invalid 3D rule '" + ruleNotation + "'");
+        options.rule3D = *rule;
+    } else if (!ruleNotation.empty()) {
+        std::optional<Rule> rule = Rules::parse(ruleNotation);
+        if (!rule)
+            throw std::invalid_argument("--rule: invalid rule '" + ruleNotation + "'");
+        options.rule = *rule;
+    }
+    return options;
+}
+
+const char* HeadlessRunner::getUsage()
+{
+    return "Usage: simulation --headless [options]\n"
+           "  --help                 Show this list\n"
+           "  --rule NOTATION        B/S, Generations or Larger than Life rule (default B3/S23);\n"
+           "                         S/B/C/N or Bays rule for volumes (default 4/4/5/M)\n"
+           "  --size WxH[xD]         Grid size (default 1024x1024); a depth simulates a 3D volume\n"
+           "  --gens N               Generations to simulate (default 1000)\n"
+           "  --seed N               Seed of the initial soup (default: random, reported on exit)\n"
+           "  --density P            Probability of each initial live cell (default 0.3)\n"
+           "  --layout bytes|bits|tiled\n"
+           "                         Grid storage (default bits, 2D only)\n"
+           "  --boundary dead|torus|mirror\n"
+           "                         Edge handling (default torus)\n"
+           "  --threads N            Worker threads including the main one (default: all cores)\n"
+           "  --steps-per-pass N     Generations per temporal-blocking pass (default 1, 2D only)\n"
+           "  --stats-every N        Generations between rows of the stats file (default gens / 100)\n"
+           "  --stats PATH           Statistics CSV (default stats.csv)\n"
+           "  --out PATH             Final state as RLE (default final.rle)\n";
+}
+
+HeadlessRunner::HeadlessRunner(const HeadlessOptions& options) : options(options) { }
+
+void HeadlessRunner::run()
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    auto secondsSince = [](Clock::time_point from) {
+        return std::chrono::duration<double>(Clock::now() - from).count();
+    };
+
+    if (options.randomSeed) {
+        std::random_device device;
+        options.seed = (static_cast<uint64_t>(device()) << 32) | device();
+    }
+    if (options.depth > 0) {
+        runVolume(start);
+        return;
+    }
+
+    Grid2D grid(options.width, options.height, options.layout);
+    grid.setBoundary(options.boundary);
+    Simulator simulator(grid);
+    if (options.threadCount > 0)
+        simulator.setThreadCount(options.threadCount);
+    simulator.setRule(options.rule);
+    simulator.setStepsPerPass(options.stepsPerPass);
+    // La sopa inicial de un grid grande también se reparte por filas, con los hilos del simulador
+    grid.randomize(options.density, options.seed, simulator.getThreadPool());
+
+    std::ofstream statsFile(options.statsPath);
+    if (!statsFile)
+        throw std::runtime_error("Failed to open stats file: " + options.statsPath);
+    statsFile << "generation,population,births,deaths,changed,period,seconds,generations_per_second\n";
+
+    // Las muestras caen en múltiplos de la pasada: cambiar stepsPerPass marca todos los tiles como cambiados
+    const int64_t stepsPerPass = simulator.getStepsPerPass();
+    int64_t interval = options.statsInterval;
+    if (interval == 0)
+        interval = std::max<int64_t>(options.generations / 100, 1);
+    interval = (interval + stepsPerPass - 1) / stepsPerPass * stepsPerPass;
+
+    Stats stats;
+    const Clock::time_point runStart = Clock::now();
+    const double setupSeconds = secondsSince(start);
+    Clock::time_point sampleTime = runStart;
+    int64_t sampleGeneration = simulator.getGeneration();
+    auto writeSample = [&]() {
+        const double seconds = secondsSince(sampleTime);
+        const int64_t generation = simulator.getGeneration();
+        stats.update(grid, static_cast<float>(seconds));
+        stats.setCycle(simulator.getCycle());
+        const StepCounts& lastStep = stats.getLastStep();
+        statsFile << generation << ',' << grid.getPopulation() << ',' << lastStep.births << ',' << lastStep.deaths
+                  << ',' << lastStep.changed << ',' << stats.getCycle().period << ',' << secondsSince(runStart) << ','
+                  << (seconds > 0.0 ? static_cast<double>(generation - sampleGeneration) / seconds : 0.0) << '\n';
+        sampleTime = Clock::now();
+        sampleGeneration = generation;
+    };
+
+    writeSample();
+    while (simulator.getGeneration() < options.generations) {
+        const int64_t target = std::min(options.generations, (simulator.getGeneration() / interval + 1) * interval);
+
+        // En un ciclo detectado la siguiente muestra se alcanza sin simular los periodos completos
+        while (simulator.getGeneration() < target && !simulator.fastForward(target)) {
+            if (target - simulator.getGeneration() < stepsPerPass)
+                simulator.setStepsPerPass(static_cast<int>(target - simulator.getGeneration()));
+            simulator.step();
+        }
+        writeSample();
+    }
+    statsFile.close();
+    if (!statsFile)
+        throw std::runtime_error("Failed to write stats file: " + options.statsPath);
+    const double runSeconds = secondsSince(runStart);
+
+    std::ofstream stateFile(options.statePath);
+    if (!stateFile)
+        throw std::runtime_error("Failed to open state file: " + options.statePath);
+    stateFile << "#C Generation " << simulator.getGeneration() << " from a soup of density " << options.density
+              << ", seed " << options.seed << '\n';
+    stateFile << "x = " << grid.getWidth() << ", y = " << grid.getHeight()
+              << ", rule = " << Rules::toNotation(options.rule) << '\n';
+    RleWriter(stateFile, options.rule.states).write(grid);
+    stateFile.close();
+    if (!stateFile)
+        throw std::runtime_error("Failed to write state file: " + options.statePath);
+
+    const int64_t generations = simulator.getGeneration();
+    std::cout << "Simulated " << generations << " generations of " << grid.getWidth() << "x" << grid.getHeight() << " "
+              << Rules::toNotation(options.rule) << " (seed " << options.seed << ") in " << runSeconds << " s, "
+              << (runSeconds > 0.0 ? static_cast<double>(generations) / runSeconds : 0.0) << " gen/s; setup "
+              << setupSeconds * 1000.0 << " ms" << std::endl;
+    std::cout << "Population: " << grid.getPopulation() << "; wrote " << options.statsPath << " and "
+              << options.statePath << std::endl;
+}
+
+void HeadlessRunner::runVolume(std::chrono::steady_clock::time_point start)
+{
+    using Clock = std::chrono::steady_clock;
+    auto secondsSince = [](Clock::time_point from) {
+        return std::chrono::duration<double>(Clock::now() - from).count();
+    };
+
+    Grid3D grid(options.width, options.height, options.depth);
+    grid.setBoundary(options.boundary);
+    Simulator3D simulator(grid);
+    if (options.threadCount > 0)
+        simulator.setThreadCount(options.threadCount);
+    simulator.setRule(options.rule3D);
+    grid.randomize(options.density, options.seed, simulator.getThreadPool());
+
+    std::ofstream statsFile(options.statsPath);
+    if (!statsFile)
+        throw std::runtime_error("Failed to open stats file: " + options.statsPath);
+    // Mismas columnas que en 2D; el motor 3D no detecta ciclos y el periodo queda en 0
+    statsFile << "generation,population,births,deaths,changed,period,seconds,generations_per_second\n";
+
+    int64_t interval = options.statsInterval;
+    if (interval == 0)
+        interval = std::max<int64_t>(options.generations / 100, 1);
+
+    Stats stats;
+    const Clock::time_point runStart = Clock::now();
+    const double setupSeconds = secondsSince(start);
+    Clock::time_point sampleTime = runStart;
+    int64_t sampleGeneration = simulator.getGeneration();
+    auto writeSample = [&]() {
+        const double seconds = secondsSince(sampleTime);
+        const int64_t generation = simulator.getGeneration();
+        stats.update(grid, static_cast<float>(seconds));
+        const StepCounts& lastStep = stats.getLastStep();
+        statsFile << generation << ',' << grid.getPopulation() << ',' << lastStep.births << ',' << lastStep.deaths
+                  << ',' << lastStep.changed << ",0," << secondsSince(runStart) << ','
+                  << (seconds > 0.0 ? static_cast<double>(generation - sampleGeneration) / seconds : 0.0) << '\n';
+        sampleTime = Clock::now();
+        sampleGeneration = generation;
+    };
+
+    writeSample();
+    while (simulator.getGeneration() < options.generations) {
+        const int64_t target = std::min(options.generations, (simulator.getGeneration() / interval + 1) * interval);
+        while (simulator.getGeneration() < target)
+            simulator.step();
+        writeSample();
+    }
+    statsFile.close();
+    if (!statsFile)
+        throw std::runtime_error("Failed to write stats file: " + options.statsPath);
+    const double runSeconds = secondsSince(runStart);
+
+    const std::string notation = Rules3D::toNotation(options.rule3D);
+    std::ofstream stateFile(options.statePath);
+    if (!stateFile)
+        throw std::runtime_error("Failed to open state file: " + options.statePath);
+    stateFile << "#C Generation " << simulator.getGeneration() << " from a soup of density " << options.density
+              << ", seed " << options.seed << '\n';
+    stateFile << "x = " << grid.getWidth() << ", y = " << grid.getHeight() << ", z = " << grid.getDepth()
+              << ", rule = " << notation << '\n';
+    RleWriter(stateFile, options.rule3D.states).write(grid);
+    stateFile.close();
+    if (!stateFile)
+        throw std::runtime_error("Failed to write state file: " + options.statePath);
+
+    const int64_t generations = simulator.getGeneration();
+    std::cout << "Simulated " << generations << " generations of " << grid.getWidth() << "x" << grid.getHeight() << "x"
+              << grid.getDepth() << " " << notation << " (seed " << options.seed << ") in " << runSeconds << " s, "
+              << (runSeconds > 0.0 ? static_cast<double>(generations) / runSeconds : 0.0) << " gen/s; setup "
+              << setupSeconds * 1000.0 << " ms" << std::endl;
+    std::cout << "Population: " << grid.getPopulation() << "; wrote " << options.statsPath << " and "
+              << options.statePath << std::endl;
+}
+
+}  // namespace Core
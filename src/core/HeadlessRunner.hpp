@@ -0,0 +1,107 @@
+/**
+ * @file HeadlessRunner.hpp
+ * @brief Ejecución por lotes sin ventana ni contexto GL
+ *
+ * Avanza un grid desde una sopa aleatoria hasta un número de generaciones y
+ * escribe las estadísticas (CSV) y el estado final (RLE) en ficheros. Solo
+ * usa el núcleo (Grid2D, Rules, Simulator, Stats), así que arranca en
+ * milisegundos y funciona en máquinas sin pantalla:
+ *
+ *     simulation --headless --rule B3/S23 --size 16384x16384 --gens 100000 --seed 42
+ *
+ * Con una tercera dimensión en --size se simula un volumen con Grid3D y
+ * Simulator3D, y --rule usa la notación de Rules3D:
+ *
+ *     simulation --headless --rule 4/4/5/M --size 256x256x256 --gens 500
+ */
+
+#ifndef HEADLESS_RUNNER_HPP
+#define HEADLESS_RUNNER_HPP
+
+#include "Grid2D.hpp"
+#include "Rules.hpp"
+#include "Rules3D.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Core {
+
+/**
+ * @struct HeadlessOptions
+ * @brief Parámetros de una ejecución por lotes
+ */
+struct HeadlessOptions {
+    Rule rule = Rules::fromType(RuleType::CONWAY);
+    int width = 1024;
+    int height = 1024;
+    int depth = 0;  // > 0 = volumen 3D (--size WxHxD)
+    Rule3D rule3D = Rules3D::make(1u << 4, 1u << 4, 5, Neighborhood::MOORE);
+    int64_t generations = 1000;
+    uint64_t seed = 0;
+    bool randomSeed = true;  // Sin --seed se elige una y se informa de ella
+    float density = 0.3f;    // Probabilidad inicial de cada celda (ver Grid2D::randomize)
+    GridLayout layout = GridLayout::BITS;
+    BoundaryMode boundary = BoundaryMode::TORUS;
+    int threadCount = 0;        // 0 = núcleos disponibles
+    int stepsPerPass = 1;       // Ver Simulator::setStepsPerPass
+    int64_t statsInterval = 0;  // Generaciones entre filas del CSV (0 = una centésima del total)
+    std::string statsPath = "stats.csv";
+    std::string statePath = "final.rle";
+};
+
+/**
+ * @class HeadlessRunner
+ * @brief Ejecuta una simulación sin interfaz y guarda sus resultados
+ */
+class HeadlessRunner {
+public:
+    /**
+     * @brief Verifica si la línea de comandos contiene una opción sin valor
+     * @param argc Número de argumentos
+     * @param argv Argumentos
+     * @param flag Opción ("--headless", "--help")
+     * @return true si aparece
+     */
+    static bool hasFlag(int argc, char* argv[], const char* flag);
+
+    /**
+     * @brief Interpreta la línea de comandos
+     * @param argc Número de argumentos
+     * @param argv Argumentos (--headless y --help se aceptan y se ignoran)
+     * @return Opciones
+     * @throws std::invalid_argument Si una opción no existe o su valor no es válido
+     */
+    static HeadlessOptions parseArguments(int argc, char* argv[]);
+
+    /**
+     * @brief Texto de ayuda con las opciones
+     * @return Uso del modo sin ventana
+     */
+    static const char* getUsage();
+
+    /**
+     * @brief Constructor
+     * @param options Parámetros de la ejecución
+     */
+    explicit HeadlessRunner(const HeadlessOptions& options);
+
+    /**
+     * @brief Simula hasta options.generations y escribe los ficheros de salida
+     * @throws std::runtime_error Si no se puede escribir un fichero
+     */
+    void run();
+
+private:
+    HeadlessOptions options;
+
+    /**
+     * @brief Simula el volumen 3D de options y escribe los ficheros de salida
+     * @param start Momento en que empezó run() (para el tiempo de preparación)
+     */
+    void runVolume(std::chrono::steady_clock::time_point start);
+};
+
+}  // namespace Core
+
+#endif  // HEADLESS_RUNNER_HPP
@@ -4,8 +4,6 @@
  */
 
 #include "InputManager.hpp"
-#include "Grid2D.hpp"
-#include "Simulator.hpp"
 #include <glm/glm.hpp>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -14,8 +12,8 @@ namespace Core {
 
 InputManager* InputManager::instance = nullptr;
 
-InputManager::InputManager(GLFWwindow* window, Renderer::Camera& camera, Grid2D& grid, Simulator& simulator) :
-    window(window), camera(camera), grid(grid), simulator(simulator), lastX(400.0f), lastY(300.0f), firstMouse(true),
+InputManager::InputManager(GLFWwindow* window, Renderer::Camera& camera, SimulationThread& simulation) :
+    window(window), camera(camera), simulation(simulation), lastX(400.0f), lastY(300.0f), firstMouse(true),
     mousePressed(false)
 {
     // Configurar callbacks
@@ -42,7 +40,7 @@ void InputManager::processKeyboard(float deltaTime)
     // SPACE para pausar/reanudar (evitar spam con static)
     static bool spacePressed = false;
     if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS && !spacePressed) {
-        simulator.togglePause();
+        simulation.submit([](Simulator& simulator, Grid2D&) { simulator.togglePause(); });
         spacePressed = true;
     }
     if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_RELEASE) {
@@ -52,7 +50,7 @@ void InputManager::processKeyboard(float deltaTime)
     // R para randomizar
     static bool rPressed = false;
     if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS && !rPressed) {
-        grid.randomize(0.3f);
+        simulation.submit([](Simulator&, Grid2D& grid) { grid.randomize(0.3f); });
         rPressed = true;
     }
     if (glfwGetKey(window, GLFW_KEY_R) == GLFW_RELEASE) {
@@ -62,7 +60,7 @@ void InputManager::processKeyboard(float deltaTime)
     // C para limpiar
     static bool cPressed = false;
     if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS && !cPressed) {
-        grid.clear();
+        simulation.submit([](Simulator&, Grid2D& grid) { grid.clear(); });
         cPressed = true;
     }
     if (glfwGetKey(window, GLFW_KEY_C) == GLFW_RELEASE) {
@@ -72,7 +70,7 @@ void InputManager::processKeyboard(float deltaTime)
     // N para cambiar reglas
     static bool nPressed = false;
     if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS && !nPressed) {
-        simulator.nextRule();
+        simulation.submit([](Simulator& simulator, Grid2D&) { simulator.nextRule(); });
         nPressed = true;
     }
     if (glfwGetKey(window, GLFW_KEY_N) == GLFW_RELEASE) {
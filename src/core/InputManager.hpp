@@ -8,8 +8,7 @@
 #define INPUT_MANAGER_HPP
 
 #include <GLFW/glfw3.h>
-#include "Grid2D.hpp"
-#include "Simulator.hpp"
+#include "SimulationThread.hpp"
 #include "renderer/Camera.hpp"
 
 namespace Core {
@@ -24,10 +23,9 @@ public:
      * @brief Constructor
      * @param window Puntero a la ventana GLFW
      * @param camera Referencia a la cámara
-     * @param grid Referencia al grid de simulación
-     * @param simulator Referencia al simulador
+     * @param simulation Hilo de simulación (las teclas le envían órdenes)
      */
-    InputManager(GLFWwindow* window, Renderer::Camera& camera, Grid2D& grid, Simulator& simulator);
+    InputManager(GLFWwindow* window, Renderer::Camera& camera, SimulationThread& simulation);
 
     /**
      * @brief Procesa input del teclado
@@ -44,8 +42,7 @@ public:
 private:
     GLFWwindow* window;
     Renderer::Camera& camera;
-    Grid2D& grid;
-    Simulator& simulator;
+    SimulationThread& simulation;
 
     // Estado del mouse
     float lastX, lastY;
@@ -0,0 +1,180 @@
+/**
+ * @file LargerThanLife.cpp
+ * @brief Implementación del motor Larger than Life
+ */
+
+#include "LargerThanLife.hpp"
+#include <algorithm>
+
+namespace Core {
+
+StepCounts LargerThanLife::step(Grid2D& grid, const Rule& rule, ThreadPool* pool)
+{
+    width = grid.getWidth();
+    height = grid.getHeight();
+    grid.readStates(states);
+    next.resize(states.size());
+    counts.resize(states.size());
+
+    buildPadded(rule.radius, grid.getBoundary());
+    if (rule.neighborhood == Neighborhood::MOORE) {
+        countMoore(rule.radius, pool);
+    } else {
+        countVonNeumann(rule.radius, pool);
+    }
+
+    const int stateCount = rule.states;
+    const CellState dying = stateCount > 2 ? static_cast<CellState>(2) : CellState::DEAD;
+    const int self = rule.includeCenter ? 0 : 1;
+
+    ThreadPool::run(pool, height, [&](int begin, int end) {
+        for (size_t i = static_cast<size_t>(begin) * width; i < static_cast<size_t>(end) * width; ++i) {
+            int state = static_cast<int>(states[i]);
+            int count = static_cast<int>(counts[i]) - (state == 1 ? self : 0);
+            if (state == 0) {
+                next[i] = (count >= rule.birthMin && count <= rule.birthMax) ? CellState::ALIVE : CellState::DEAD;
+            } else if (state == 1) {
+                next[i] = (count >= rule.survivalMin && count <= rule.survivalMax) ? CellState::ALIVE : dying;
+            } else {
+                next[i] = static_cast<CellState>((state + 1) % stateCount);
+            }
+        }
+    });
+
+    // Contadores de la generación; sin cambios el grid no se reescribe
+    StepCounts step;
+    for (size_t i = 0; i < states.size(); ++i) {
+        bool wasAlive = states[i] == CellState::ALIVE;
+        bool isAlive = next[i] == CellState::ALIVE;
+        step.births += isAlive && !wasAlive;
+        step.deaths += wasAlive && !isAlive;
+        step.changed += states[i] != next[i];
+    }
+    if (step.changed > 0)
+        grid.writeStates(next);
+    return step;
+}
+
+void LargerThanLife::buildPadded(int radius, BoundaryMode boundary)
+{
+    paddedWidth = width + 2 * radius;
+    paddedHeight = height + 2 * radius;
+    alive.assign(static_cast<size_t>(paddedWidth) * paddedHeight, 0);
+
+    // Columna de origen de cada columna del halo (-1 = muerta)
+    std::vector<int> sourceX(paddedWidth);
+    for (int i = 0; i < paddedWidth; ++i)
+        sourceX[i] = Grid2D::wrapCoordinate(i - radius, width, boundary);
+
+    for (int j = 0; j < paddedHeight; ++j) {
+        int sy = Grid2D::wrapCoordinate(j - radius, height, boundary);
+        if (sy < 0)
+            continue;
+        const CellState* row = states.data() + static_cast<size_t>(sy) * width;
+        uint8_t* out = alive.data() + static_cast<size_t>(j) * paddedWidth;
+        for (int i = 0; i < paddedWidth; ++i)
+            out[i] = sourceX[i] >= 0 && row[sourceX[i]] == CellState::ALIVE;
+    }
+}
+
+void LargerThanLife::countMoore(int radius, ThreadPool* pool)
+{
+    const size_t stride = static_cast<size_t>(paddedWidth) + 1;
+    sums.assign(stride * (paddedHeight + 1), 0);
+
+    // sums[j][i] = celdas vivas en [0, i) x [0, j) del grid con halo. Por encima de 2^32 celdas los
+    // prefijos dan la vuelta, pero las diferencias de cada cuadrado siguen siendo exactas módulo 2^32
+    for (int j = 0; j < paddedHeight; ++j) {
+        const uint8_t* row = alive.data() + static_cast<size_t>(j) * paddedWidth;
+        const uint32_t* above = sums.data() + static_cast<size_t>(j) * stride;
+        uint32_t* current = sums.data() + static_cast<size_t>(j + 1) * stride;
+        uint32_t rowSum = 0;
+        for (int i = 0; i < paddedWidth; ++i) {
+            rowSum += row[i];
+            current[i + 1] = above[i + 1] + rowSum;
+        }
+    }
+
+    // La celda (x, y) está en (x + r, y + r): su cuadrado es [x, x + 2r] x [y, y + 2r], sin recortes
+    const int side = 2 * radius + 1;
+    ThreadPool::run(pool, height, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            const uint32_t* top = sums.data() + static_cast<size_t>(y) * stride;
+            const uint32_t* bottom = sums.data() + static_cast<size_t>(y + side) * stride;
+            uint32_t* out = counts.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; ++x)
+                out[x] = bottom[x + side] - bottom[x] - top[x + side] + top[x];
+        }
+    });
+}
+
+void LargerThanLife::countVonNeumann(int radius, ThreadPool* pool)
+{
+    const int w = paddedWidth;
+    const int h = paddedHeight;
+    diagDown.resize(alive.size());
+    diagUp.resize(alive.size());
+
+    // diagDown(i, j) = suma de (i - k, j - k); diagUp(i, j) = suma de (i + k, j - k), k >= 0
+    for (int j = 0; j < h; ++j) {
+        const uint8_t* row = alive.data() + static_cast<size_t>(j) * w;
+        uint32_t* down = diagDown.data() + static_cast<size_t>(j) * w;
+        uint32_t* up = diagUp.data() + static_cast<size_t>(j) * w;
+        const uint32_t* downAbove = j > 0 ? down - w : nullptr;
+        const uint32_t* upAbove = j > 0 ? up - w : nullptr;
+        for (int i = 0; i < w; ++i) {
+            down[i] = row[i] + ((downAbove && i > 0) ? downAbove[i - 1] : 0);
+            up[i] = row[i] + ((upAbove && i + 1 < w) ? upAbove[i + 1] : 0);
+        }
+    }
+
+    // Suma de la diagonal i - j = d con j en [j0, j1], recortada al grid con halo
+    auto sumDown = [&](int d, int j0, int j1) -> uint32_t {
+        int lo = std::max({ j0, 0, -d });
+        int hi = std::min({ j1, h - 1, w - 1 - d });
+        if (lo > hi)
+            return 0;
+        uint32_t total = diagDown[static_cast<size_t>(hi) * w + d + hi];
+        if (lo > 0 && d + lo > 0)
+            total -= diagDown[static_cast<size_t>(lo - 1) * w + d + lo - 1];
+        return total;
+    };
+
+    // Suma de la diagonal i + j = c con j en [j0, j1], recortada al grid con halo
+    auto sumUp = [&](int c, int j0, int j1) -> uint32_t {
+        int lo = std::max({ j0, 0, c - (w - 1) });
+        int hi = std::min({ j1, h - 1, c });
+        if (lo > hi)
+            return 0;
+        uint32_t total = diagUp[static_cast<size_t>(hi) * w + c - hi];
+        if (lo > 0 && c - lo + 1 < w)
+            total -= diagUp[static_cast<size_t>(lo - 1) * w + c - lo + 1];
+        return total;
+    };
+
+    auto at = [&](int i, int j) -> uint32_t { return (j >= 0 && j < h) ? alive[static_cast<size_t>(j) * w + i] : 0; };
+
+    // Cada banda de columnas desplaza sus rombos desde j = -r-1 (vacío) hasta la última fila del grid.
+    // La celda (x, y) es el centro (x + r, y + r) del grid con halo
+    ThreadPool::run(pool, width, [&](int begin, int end) {
+        std::vector<uint32_t> diamond(end - begin, 0);
+        for (int j = -radius; j < height + radius; ++j) {
+            uint32_t* out = j >= radius ? counts.data() + static_cast<size_t>(j - radius) * width : nullptr;
+            for (int x = begin; x < end; ++x) {
+                int i = x + radius;
+                // Borde inferior del rombo en j y borde superior del rombo en j-1 (vértices compartidos)
+                uint32_t enter = sumDown(i - radius - j, j, j + radius) + sumUp(i + j + radius, j, j + radius) -
+                                 at(i, j + radius);
+                int jp = j - 1;
+                uint32_t leave = sumUp(i - radius + jp, jp - radius, jp) + sumDown(i - jp + radius, jp - radius, jp) -
+                                 at(i, jp - radius);
+                uint32_t& sum = diamond[x - begin];
+                sum += enter - leave;
+                if (out)
+                    out[x] = sum;
+            }
+        }
+    });
+}
+
+}  // namespace Core
@@ -0,0 +1,73 @@
+/**
+ * @file LargerThanLife.hpp
+ * @brief Motor de reglas Larger than Life (vecindarios de radio arbitrario)
+ *
+ * Los vecinos de cada celda salen de tablas de sumas reconstruidas una vez por
+ * generación, así que el coste por celda no depende del radio: una tabla de
+ * áreas sumadas para Moore y prefijos diagonales con sumas corridas para von
+ * Neumann. El borde se resuelve con un halo de ancho igual al radio, relleno
+ * según el modo de borde del grid.
+ */
+
+#ifndef LARGER_THAN_LIFE_HPP
+#define LARGER_THAN_LIFE_HPP
+
+#include "Grid2D.hpp"
+#include "Rules.hpp"
+#include "ThreadPool.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class LargerThanLife
+ * @brief Paso de reglas con rangos sobre el grid acotado
+ */
+class LargerThanLife {
+public:
+    /**
+     * @brief Calcula la siguiente generación del grid
+     * @param grid Grid a avanzar (cualquier layout)
+     * @param rule Regla Larger than Life
+     * @param pool Hilos para repartir el trabajo (nullptr = en serie)
+     * @return Nacimientos, muertes y celdas cambiadas (el grid solo se reescribe si changed > 0)
+     */
+    StepCounts step(Grid2D& grid, const Rule& rule, ThreadPool* pool = nullptr);
+
+private:
+    int width = 0;
+    int height = 0;
+    int paddedWidth = 0;   // width + 2r
+    int paddedHeight = 0;  // height + 2r
+    std::vector<CellState> states;  // Estado actual
+    std::vector<CellState> next;    // Siguiente estado
+    std::vector<uint8_t> alive;     // Celdas vivas con halo de r celdas (paddedWidth x paddedHeight)
+    // Sin signo: las sumas acumuladas dan la vuelta módulo 2^32 de forma definida y sus diferencias son exactas
+    std::vector<uint32_t> counts;    // Vecinos vivos de cada celda
+    std::vector<uint32_t> sums;      // Moore: áreas sumadas, (paddedWidth+1) x (paddedHeight+1)
+    std::vector<uint32_t> diagDown;  // von Neumann: prefijos a lo largo de cada diagonal "\"
+    std::vector<uint32_t> diagUp;    // von Neumann: prefijos a lo largo de cada diagonal "/"
+
+    /**
+     * @brief Copia las celdas vivas con un halo de r celdas según el modo de borde
+     */
+    void buildPadded(int radius, BoundaryMode boundary);
+
+    /**
+     * @brief Cuenta vecinos en cuadrados de lado 2r+1 (celda incluida)
+     */
+    void countMoore(int radius, ThreadPool* pool);
+
+    /**
+     * @brief Cuenta vecinos en rombos |dx| + |dy| <= r (celda incluida)
+     *
+     * Cada columna mantiene la suma del rombo y la desplaza hacia abajo:
+     * entra el borde inferior (dos segmentos diagonales) y sale el superior.
+     */
+    void countVonNeumann(int radius, ThreadPool* pool);
+};
+
+}  // namespace Core
+
+#endif  // LARGER_THAN_LIFE_HPP
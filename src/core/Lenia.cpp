@@ -0,0 +1,178 @@
+/**
+ * @file Lenia.cpp
+ * @brief Implementación del motor Lenia
+ */
+
+#include "Lenia.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Core {
+
+namespace {
+
+/**
+ * @brief Perfil de un anillo: campana suave en (0, 1) con máximo 1 en q = 0.5
+ */
+float ringCore(float q)
+{
+    if (q <= 0.0f || q >= 1.0f)
+        return 0.0f;
+    return std::exp(4.0f - 1.0f / (q * (1.0f - q)));
+}
+
+}  // namespace
+
+void Lenia::setRule(const LeniaRule& newRule)
+{
+    LeniaRule clamped = newRule;
+    clamped.radius = std::clamp(clamped.radius, MIN_RADIUS, MAX_RADIUS);
+    if (clamped.peaks.empty())
+        clamped.peaks = { 1.0f };
+    if (clamped.radius != rule.radius || clamped.peaks != rule.peaks)
+        planValid = false;
+    rule = clamped;
+}
+
+void Lenia::resize(int newWidth, int newHeight)
+{
+    width = newWidth;
+    height = newHeight;
+    field.assign(static_cast<size_t>(width) * height, 0.0f);
+    planValid = false;
+}
+
+void Lenia::loadFromGrid(const Grid2D& grid)
+{
+    if (grid.getWidth() != width || grid.getHeight() != height)
+        resize(grid.getWidth(), grid.getHeight());
+
+    std::vector<CellState> states;
+    grid.readStates(states);
+    for (size_t i = 0; i < states.size(); ++i)
+        field[i] = states[i] == CellState::ALIVE ? 1.0f : 0.0f;
+}
+
+void Lenia::storeToGrid(Grid2D& grid) const
+{
+    std::vector<CellState> states(field.size());
+    for (size_t i = 0; i < field.size(); ++i)
+        states[i] = field[i] >= 0.5f ? CellState::ALIVE : CellState::DEAD;
+    grid.writeStates(states);
+}
+
+void Lenia::randomize(int newWidth, int newHeight, float density, uint64_t seed)
+{
+    resize(newWidth, newHeight);
+
+    // Cuadrado central de unos seis radios: una sopa que cubre todo el campo suele saturarlo
+    const int sideX = std::min(width, 6 * rule.radius);
+    const int sideY = std::min(height, 6 * rule.radius);
+    const int x0 = (width - sideX) / 2;
+    const int y0 = (height - sideY) / 2;
+    for (int y = y0; y < y0 + sideY; ++y) {
+        for (int x = x0; x < x0 + sideX; ++x) {
+            uint64_t cell = static_cast<uint64_t>(y) * width + x;
+            if (Random::uniform(seed, 2 * cell) < density)
+                field[cell] = Random::uniform(seed, 2 * cell + 1);
+        }
+    }
+}
+
+void Lenia::preparePlan(BoundaryMode boundary, ThreadPool* pool)
+{
+    if (planValid && boundary == planBoundary)
+        return;
+
+    // En un toro de lado potencia de dos la convolución circular es la del propio campo
+    const int radius = rule.radius;
+    const bool torus = boundary == BoundaryMode::TORUS;
+    haloX = torus && width >= 2 && Fft::isPowerOfTwo(width) ? 0 : radius;
+    haloY = torus && Fft::isPowerOfTwo(height) ? 0 : radius;
+    const int fftWidth = Fft::nextPowerOfTwo(std::max(2, width + 2 * haloX));
+    const int fftHeight = Fft::nextPowerOfTwo(height + 2 * haloY);
+    fft = std::make_unique<RealFft2D>(fftWidth, fftHeight);
+    padded.assign(static_cast<size_t>(fftWidth) * fftHeight, 0.0f);
+    spectrum.resize(static_cast<size_t>(fftHeight) * fft->getSpectrumWidth());
+
+    // Kernel centrado en (0, 0) con coordenadas negativas envueltas; normalizado a suma 1
+    const int rings = static_cast<int>(rule.peaks.size());
+    double total = 0.0;
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            float r = std::sqrt(static_cast<float>(dx * dx + dy * dy)) / radius;
+            if (r >= 1.0f)
+                continue;
+            float scaled = r * rings;
+            int ring = std::min(static_cast<int>(scaled), rings - 1);
+            float weight = rule.peaks[ring] * ringCore(scaled - ring);
+            int px = ((dx % fftWidth) + fftWidth) % fftWidth;
+            int py = ((dy % fftHeight) + fftHeight) % fftHeight;
+            padded[static_cast<size_t>(py) * fftWidth + px] += weight;
+            total += weight;
+        }
+    }
+
+    // La inversa de la FFT no normaliza: el factor va en el kernel
+    const float scale = static_cast<float>(1.0 / (total * fftWidth * fftHeight));
+    for (float& value : padded)
+        value *= scale;
+    kernelSpectrum.resize(spectrum.size());
+    fft->forward(padded.data(), kernelSpectrum.data(), pool);
+
+    planBoundary = boundary;
+    planValid = true;
+}
+
+void Lenia::step(BoundaryMode boundary, ThreadPool* pool)
+{
+    if (field.empty())
+        return;
+    preparePlan(boundary, pool);
+
+    const int fftWidth = fft->getWidth();
+    const int fftHeight = fft->getHeight();
+
+    // 1. Campo con halo: fila/columna (p - halo) según el modo de borde, ceros en el relleno sobrante
+    ThreadPool::run(pool, fftHeight, [&](int begin, int end) {
+        for (int py = begin; py < end; ++py) {
+            float* row = padded.data() + static_cast<size_t>(py) * fftWidth;
+            int y = py - haloY;
+            int sourceY = y < height + haloY ? Grid2D::wrapCoordinate(y, height, boundary) : -1;
+            if (sourceY < 0) {
+                std::fill_n(row, fftWidth, 0.0f);
+                continue;
+            }
+            const float* source = field.data() + static_cast<size_t>(sourceY) * width;
+            for (int px = 0; px < fftWidth; ++px) {
+                int x = px - haloX;
+                int sourceX = x < width + haloX ? Grid2D::wrapCoordinate(x, width, boundary) : -1;
+                row[px] = sourceX < 0 ? 0.0f : source[sourceX];
+            }
+        }
+    });
+
+    // 2. U = K * A en frecuencia
+    fft->forward(padded.data(), spectrum.data(), pool);
+    fft->multiplySpectrum(spectrum.data(), kernelSpectrum.data(), pool);
+    fft->inverse(spectrum.data(), padded.data(), pool);
+
+    // 3. A += dt * G(U), G(u) = 2 exp(-(u - mu)^2 / (2 sigma^2)) - 1, recortado a [0, 1]
+    const float mu = rule.mu;
+    const float inverseTwoSigma2 = 1.0f / (2.0f * rule.sigma * rule.sigma);
+    const float dt = rule.dt;
+    ThreadPool::run(pool, height, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            const float* potential = padded.data() + static_cast<size_t>(y + haloY) * fftWidth + haloX;
+            float* row = field.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; ++x) {
+                float d = potential[x] - mu;
+                float growth = 2.0f * std::exp(-d * d * inverseTwoSigma2) - 1.0f;
+                row[x] = std::clamp(row[x] + dt * growth, 0.0f, 1.0f);
+            }
+        }
+    });
+}
+
+}  // namespace Core
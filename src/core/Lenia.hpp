@@ -0,0 +1,141 @@
+/**
+ * @file Lenia.hpp
+ * @brief Motor de autómatas continuos tipo Lenia (estados y kernel continuos)
+ *
+ * Cada celda guarda un valor en [0, 1]. El potencial U de una celda es la
+ * convolución del campo con un kernel de anillos de radio R, y el campo avanza
+ * A += dt * G(U) con una función de crecimiento gaussiana. La convolución se
+ * hace en frecuencia con RealFft2D, así que su coste no depende del radio. El
+ * borde se resuelve con un halo de ancho R relleno según el modo de borde
+ * (en un toro de lado potencia de dos la convolución circular ya es exacta).
+ */
+
+#ifndef LENIA_HPP
+#define LENIA_HPP
+
+#include "Fft.hpp"
+#include "Grid2D.hpp"
+#include "ThreadPool.hpp"
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @struct LeniaRule
+ * @brief Kernel y función de crecimiento (por defecto, los de Orbium)
+ */
+struct LeniaRule {
+    int radius = 13;                      // Radio del kernel en celdas
+    std::vector<float> peaks = { 1.0f };  // Altura de cada anillo concéntrico del kernel
+    float mu = 0.15f;                     // Potencial con crecimiento máximo
+    float sigma = 0.015f;                 // Anchura de la función de crecimiento
+    float dt = 0.1f;                      // Paso de tiempo
+
+    bool operator==(const LeniaRule& other) const = default;
+};
+
+/**
+ * @class Lenia
+ * @brief Campo continuo sobre la ventana del grid y su paso por FFT
+ */
+class Lenia {
+public:
+    // Radios admitidos por el kernel
+    static constexpr int MIN_RADIUS = 2;
+    static constexpr int MAX_RADIUS = 64;
+
+    /**
+     * @brief Establece el kernel y la función de crecimiento
+     * @param rule Regla (el radio se recorta a [MIN_RADIUS, MAX_RADIUS])
+     */
+    void setRule(const LeniaRule& rule);
+
+    /**
+     * @brief Obtiene la regla actual
+     * @return Regla
+     */
+    const LeniaRule& getRule() const { return rule; }
+
+    /**
+     * @brief Calcula la siguiente generación del campo
+     * @param boundary Modo de borde (el del grid)
+     * @param pool Hilos para la FFT y la actualización (nullptr = en serie)
+     */
+    void step(BoundaryMode boundary, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Reemplaza el campo por el contenido del grid (vivas = 1, resto = 0)
+     * @param grid Grid de origen (define el tamaño del campo)
+     */
+    void loadFromGrid(const Grid2D& grid);
+
+    /**
+     * @brief Escribe en el grid las celdas con valor >= 0.5 como vivas
+     * @param grid Grid de destino (mismo tamaño que el campo)
+     */
+    void storeToGrid(Grid2D& grid) const;
+
+    /**
+     * @brief Llena el campo con valores uniformes en un cuadrado central (reproducible)
+     * @param width Ancho del campo
+     * @param height Alto del campo
+     * @param density Fracción de celdas no nulas dentro del cuadrado
+     * @param seed Semilla (ver Random)
+     */
+    void randomize(int width, int height, float density, uint64_t seed);
+
+    /**
+     * @brief Valores del campo, fila a fila
+     * @return width * height valores en [0, 1]
+     */
+    const std::vector<float>& getField() const { return field; }
+
+    /**
+     * @brief Obtiene el ancho del campo
+     * @return Ancho
+     */
+    int getWidth() const { return width; }
+
+    /**
+     * @brief Obtiene el alto del campo
+     * @return Alto
+     */
+    int getHeight() const { return height; }
+
+private:
+    LeniaRule rule;
+    int width = 0;
+    int height = 0;
+    std::vector<float> field;
+
+    // Plan de convolución: se reconstruye al cambiar regla, tamaño o borde
+    bool planValid = false;
+    BoundaryMode planBoundary = BoundaryMode::DEAD;
+    int haloX = 0;  // Celdas de halo a cada lado (0 en un toro de lado potencia de dos)
+    int haloY = 0;
+    std::unique_ptr<RealFft2D> fft;
+    std::vector<std::complex<float>> kernelSpectrum;  // Ya escalado por 1 / (ancho * alto) de la FFT
+    std::vector<std::complex<float>> spectrum;
+    std::vector<float> padded;  // Campo con halo; tras la inversa, el potencial U
+
+    /**
+     * @brief Prepara la FFT y el espectro del kernel para el tamaño y borde actuales
+     * @param boundary Modo de borde
+     * @param pool Hilos
+     */
+    void preparePlan(BoundaryMode boundary, ThreadPool* pool);
+
+    /**
+     * @brief Redimensiona el campo (a cero) e invalida el plan
+     * @param newWidth Ancho
+     * @param newHeight Alto
+     */
+    void resize(int newWidth, int newHeight);
+};
+
+}  // namespace Core
+
+#endif  // LENIA_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file Random.hpp
+ * @brief Generador aleatorio basado en contador (SplitMix64)
+ *
+ * Cada valor depende solo de la semilla y de su posición en el flujo, sin
+ * estado compartido: cualquier hilo puede generar cualquier tramo y el
+ * resultado no depende de cómo se reparta el trabajo.
+ */
+
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * @class Random
+ * @brief Valores pseudoaleatorios indexados por (semilla, contador)
+ */
+class Random {
+public:
+    // Bits de precisión de las probabilidades de bernoulliWord
+    static constexpr int PROBABILITY_BITS = 16;
+
+    /**
+     * @brief Valor número counter del flujo de una semilla
+     * @param seed Semilla
+     * @param counter Posición en el flujo
+     * @return 64 bits pseudoaleatorios
+     */
+    static inline uint64_t at(uint64_t seed, uint64_t counter)
+    {
+        // La semilla se mezcla antes para que semillas cercanas no den flujos desplazados
+        return mix(mix(seed) + (counter + 1) * GOLDEN_GAMMA);
+    }
+
+    /**
+     * @brief Valor uniforme en [0, 1) en la posición counter del flujo
+     * @param seed Semilla
+     * @param counter Posición en el flujo
+     * @return Float con 24 bits aleatorios
+     */
+    static inline float uniform(uint64_t seed, uint64_t counter)
+    {
+        return static_cast<float>(at(seed, counter) >> 40) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * @brief Convierte una probabilidad a punto fijo para bernoulliWord
+     * @param probability Probabilidad (se recorta a [0, 1])
+     * @return Umbral en [0, 2^PROBABILITY_BITS]
+     */
+    static inline uint32_t toThreshold(float probability)
+    {
+        float scaled = std::clamp(probability, 0.0f, 1.0f) * static_cast<float>(1u << PROBABILITY_BITS);
+        return static_cast<uint32_t>(scaled + 0.5f);
+    }
+
+    /**
+     * @brief 64 bits independientes, cada uno activo con probabilidad threshold / 2^PROBABILITY_BITS
+     *
+     * Recorre los bits del umbral de menor a mayor peso combinando palabras
+     * aleatorias: con bit 1 se hace OR (la probabilidad pasa a (q + 1) / 2) y
+     * con bit 0 AND (pasa a q / 2). Usa los contadores
+     * [counter * PROBABILITY_BITS, (counter + 1) * PROBABILITY_BITS) del flujo.
+     *
+     * @param seed Semilla
+     * @param counter Índice de la palabra
+     * @param threshold Umbral de toThreshold()
+     * @return Palabra con cada bit activo según la probabilidad
+     */
+    static inline uint64_t bernoulliWord(uint64_t seed, uint64_t counter, uint32_t threshold)
+    {
+        if (threshold == 0)
+            return 0;
+        if (threshold >= (1u << PROBABILITY_BITS))
+            return ~0ULL;
+
+        // Los ceros de menor peso no cambian nada partiendo de 0
+        const uint64_t base = counter * PROBABILITY_BITS;
+        uint64_t word = 0;
+        for (int bit = std::countr_zero(threshold); bit < PROBABILITY_BITS; ++bit) {
+            uint64_t draw = at(seed, base + bit);
+            word = ((threshold >> bit) & 1) ? (word | draw) : (word & draw);
+        }
+        return word;
+    }
+
+private:
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    // Finalizador de SplitMix64
+    static inline uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+}  // namespace Core
+
+#endif  // RANDOM_HPP
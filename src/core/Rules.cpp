@@ -4,6 +4,9 @@
  */
 
 #include "Rules.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 
 namespace Core {
 
@@ -18,81 +21,288 @@ std::string Rules::getName(RuleType type)
         return "HighLife";
     case RuleType::DAY_NIGHT:
         return "Day & Night";
+    case RuleType::BRIANS_BRAIN:
+        return "Brian's Brain";
+    case RuleType::STAR_WARS:
+        return "Star Wars";
+    case RuleType::BOSCO:
+        return "Bosco's Rule";
     default:
         return "Unknown";
     }
 }
 
-CellState Rules::apply(RuleType type, CellState currentState, int neighbors)
+std::string Rules::getName(const Rule& rule)
+{
+    RuleType type = findType(rule);
+    if (type == RuleType::COUNT)
+        return toNotation(rule);
+    return getName(type);
+}
+
+Rule Rules::make(uint16_t birthMask, uint16_t survivalMask, int states)
+{
+    Rule rule;
+    rule.birthMask = birthMask & 0x1FF;
+    rule.survivalMask = survivalMask & 0x1FF;
+    rule.states = std::clamp(states, 2, Grid2D::MAX_STATES);
+
+    // Sin estados refractarios la celda que no sobrevive muere directamente
+    CellState dying = rule.states > 2 ? static_cast<CellState>(2) : CellState::DEAD;
+    for (int n = 0; n <= 8; ++n) {
+        rule.table[0][n] = ((rule.birthMask >> n) & 1) ? CellState::ALIVE : CellState::DEAD;
+        rule.table[1][n] = ((rule.survivalMask >> n) & 1) ? CellState::ALIVE : dying;
+    }
+    return rule;
+}
+
+Rule Rules::makeLargerThanLife(int radius, Neighborhood neighborhood, bool includeCenter, int birthMin, int birthMax,
+                               int survivalMin, int survivalMax, int states)
+{
+    radius = std::clamp(radius, 1, MAX_RADIUS);
+
+    // Radio 1 de Moore: es una regla B/S (la celda viva se cuenta a sí misma con M1)
+    if (radius == 1 && neighborhood == Neighborhood::MOORE) {
+        uint16_t birth = 0;
+        uint16_t survival = 0;
+        int self = includeCenter ? 1 : 0;
+        for (int n = 0; n <= 8; ++n) {
+            if (n >= birthMin && n <= birthMax)
+                birth |= static_cast<uint16_t>(1u << n);
+            if (n + self >= survivalMin && n + self <= survivalMax)
+                survival |= static_cast<uint16_t>(1u << n);
+        }
+        return make(birth, survival, states);
+    }
+
+    Rule rule = make(0, 0, states);
+    rule.radius = radius;
+    rule.neighborhood = neighborhood;
+    rule.includeCenter = includeCenter;
+    rule.birthMin = birthMin;
+    rule.birthMax = birthMax;
+    rule.survivalMin = survivalMin;
+    rule.survivalMax = survivalMax;
+    return rule;
+}
+
+Rule Rules::fromType(RuleType type)
 {
     switch (type) {
-    case RuleType::CONWAY:
-        return conway(currentState, neighbors);
     case RuleType::SEEDS:
-        return seeds(currentState, neighbors);
+        return make(SeedsRule::birthMask, SeedsRule::survivalMask);
     case RuleType::HIGHLIFE:
-        return highLife(currentState, neighbors);
+        return make(HighLifeRule::birthMask, HighLifeRule::survivalMask);
     case RuleType::DAY_NIGHT:
-        return dayNight(currentState, neighbors);
+        return make(DayNightRule::birthMask, DayNightRule::survivalMask);
+    case RuleType::BRIANS_BRAIN:
+        return make(1u << 2, 0, 3);
+    case RuleType::STAR_WARS:
+        return make(1u << 2, (1u << 3) | (1u << 4) | (1u << 5), 4);
+    case RuleType::BOSCO:
+        return makeLargerThanLife(5, Neighborhood::MOORE, true, 34, 45, 34, 58);
     default:
-        return currentState;
+        return make(ConwayRule::birthMask, ConwayRule::survivalMask);
     }
 }
 
-CellState Rules::conway(CellState current, int neighbors)
+RuleType Rules::findType(const Rule& rule)
 {
-    // Conway's Game of Life (B3/S23)
-    if (current == CellState::ALIVE) {
-        if (neighbors < 2 || neighbors > 3)
-            return CellState::DEAD;
-        return CellState::ALIVE;
-    } else {
-        if (neighbors == 3)
-            return CellState::ALIVE;
-        return CellState::DEAD;
+    for (int i = 0; i < static_cast<int>(RuleType::COUNT); ++i) {
+        RuleType type = static_cast<RuleType>(i);
+        if (fromType(type) == rule)
+            return type;
     }
+    return RuleType::COUNT;
 }
 
-CellState Rules::seeds(CellState current, int neighbors)
+std::optional<Rule> Rules::parse(const std::string& notation)
 {
-    // Seeds (B2/S)
-    // Células vivas siempre mueren, solo nacen con 2 vecinos
-    if (current == CellState::DEAD && neighbors == 2) {
-        return CellState::ALIVE;
+    if (notation.find(',') != std::string::npos)
+        return parseLargerThanLife(notation);
+
+    uint16_t masks[2] = { 0, 0 };  // [0] = nacimiento, [1] = supervivencia
+    bool seen[3] = { false, false, false };
+    int states = 2;
+
+    // Partes separadas por '/': con prefijo B/S/C en cualquier orden, o "S/B/C" sin prefijos
+    int part = 0;
+    size_t start = 0;
+    while (start <= notation.size()) {
+        size_t end = notation.find('/', start);
+        if (end == std::string::npos)
+            end = notation.size();
+        std::string token = notation.substr(start, end - start);
+        start = end + 1;
+
+        if (part >= 3)
+            return std::nullopt;
+
+        int target = (part == 0) ? 1 : (part == 1) ? 0 : 2;
+        size_t pos = 0;
+        if (!token.empty() && std::isalpha(static_cast<unsigned char>(token[0]))) {
+            char prefix = static_cast<char>(std::toupper(static_cast<unsigned char>(token[0])));
+            if (prefix == 'B')
+                target = 0;
+            else if (prefix == 'S')
+                target = 1;
+            else if (prefix == 'C' || prefix == 'G')
+                target = 2;
+            else
+                return std::nullopt;
+            pos = 1;
+        }
+        if (seen[target])
+            return std::nullopt;
+        seen[target] = true;
+
+        if (target == 2) {
+            // Número de estados: entero de 2 a MAX_STATES
+            if (pos == token.size() || token.size() - pos > 3)
+                return std::nullopt;
+            states = 0;
+            for (; pos < token.size(); ++pos) {
+                if (!std::isdigit(static_cast<unsigned char>(token[pos])))
+                    return std::nullopt;
+                states = states * 10 + (token[pos] - '0');
+            }
+            if (states < 2 || states > Grid2D::MAX_STATES)
+                return std::nullopt;
+        } else {
+            for (; pos < token.size(); ++pos) {
+                char c = token[pos];
+                if (c < '0' || c > '8')
+                    return std::nullopt;
+                masks[target] |= static_cast<uint16_t>(1u << (c - '0'));
+            }
+        }
+        part++;
     }
-    return CellState::DEAD;
+
+    if (!seen[0] || !seen[1])
+        return std::nullopt;
+    return make(masks[0], masks[1], states);
 }
 
-CellState Rules::highLife(CellState current, int neighbors)
+std::optional<Rule> Rules::parseLargerThanLife(const std::string& notation)
 {
-    // HighLife (B36/S23)
-    // Como Conway pero también nace con 6 vecinos
-    if (current == CellState::ALIVE) {
-        if (neighbors < 2 || neighbors > 3)
-            return CellState::DEAD;
-        return CellState::ALIVE;
-    } else {
-        if (neighbors == 3 || neighbors == 6)
-            return CellState::ALIVE;
-        return CellState::DEAD;
+    int radius = 1;
+    int states = 2;
+    bool includeCenter = false;
+    int range[2][2] = { { 0, -1 }, { 0, -1 } };  // [0] = nacimiento, [1] = supervivencia
+    Neighborhood neighborhood = Neighborhood::MOORE;
+    bool seen[6] = {};  // R, C, M, S, B, N
+
+    auto parseInt = [](const std::string& text, size_t& pos, int& value) {
+        size_t begin = pos;
+        value = 0;
+        while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])) && pos - begin < 6)
+            value = value * 10 + (text[pos++] - '0');
+        return pos > begin;
+    };
+
+    size_t start = 0;
+    while (start <= notation.size()) {
+        size_t end = notation.find(',', start);
+        if (end == std::string::npos)
+            end = notation.size();
+        std::string token = notation.substr(start, end - start);
+        start = end + 1;
+        if (token.empty())
+            return std::nullopt;
+
+        const char fields[] = "RCMSBN";
+        char key = static_cast<char>(std::toupper(static_cast<unsigned char>(token[0])));
+        const char* field = std::strchr(fields, key);
+        if (key == '\0' || !field || seen[field - fields])
+            return std::nullopt;
+        seen[field - fields] = true;
+
+        size_t pos = 1;
+        int value = 0;
+        switch (key) {
+        case 'R':
+            if (!parseInt(token, pos, radius) || radius < 1 || radius > MAX_RADIUS)
+                return std::nullopt;
+            break;
+        case 'C':
+            // C0 y C1 equivalen a dos estados
+            if (!parseInt(token, pos, value) || value > Grid2D::MAX_STATES)
+                return std::nullopt;
+            states = std::max(value, 2);
+            break;
+        case 'M':
+            if (!parseInt(token, pos, value) || value > 1)
+                return std::nullopt;
+            includeCenter = value == 1;
+            break;
+        case 'S':
+        case 'B': {
+            int* target = range[key == 'S' ? 1 : 0];
+            if (!parseInt(token, pos, target[0]))
+                return std::nullopt;
+            target[1] = target[0];
+            if (token.compare(pos, 2, "..") == 0) {
+                pos += 2;
+                if (!parseInt(token, pos, target[1]))
+                    return std::nullopt;
+            }
+            break;
+        }
+        default: {
+            char shape = pos < token.size() ? static_cast<char>(std::toupper(static_cast<unsigned char>(token[pos++])))
+                                            : '\0';
+            if (shape != 'M' && shape != 'N')
+                return std::nullopt;
+            neighborhood = shape == 'M' ? Neighborhood::MOORE : Neighborhood::VON_NEUMANN;
+            break;
+        }
+        }
+        if (pos != token.size())
+            return std::nullopt;
     }
+
+    // Radio, supervivencia y nacimiento son obligatorios
+    if (!seen[0] || !seen[3] || !seen[4])
+        return std::nullopt;
+    return makeLargerThanLife(radius, neighborhood, includeCenter, range[0][0], range[0][1], range[1][0], range[1][1],
+                              states);
 }
 
-CellState Rules::dayNight(CellState current, int neighbors)
+std::string Rules::toNotation(const Rule& rule)
 {
-    // Day & Night (B3678/S34678)
-    // Reglas simétricas: Birth y Survival son casi iguales
-    if (current == CellState::ALIVE) {
-        // Sobrevive con 3,4,6,7,8 vecinos
-        if (neighbors == 3 || neighbors == 4 || neighbors >= 6)
-            return CellState::ALIVE;
-        return CellState::DEAD;
-    } else {
-        // Nace con 3,6,7,8 vecinos
-        if (neighbors == 3 || neighbors >= 6)
-            return CellState::ALIVE;
-        return CellState::DEAD;
+    if (rule.isLargerThanLife()) {
+        auto appendRange = [](std::string& text, int min, int max) {
+            text += std::to_string(min);
+            text += "..";
+            text += std::to_string(max);
+        };
+        std::string text = "R";
+        text += std::to_string(rule.radius);
+        text += ",C";
+        text += std::to_string(rule.states > 2 ? rule.states : 0);
+        text += rule.includeCenter ? ",M1" : ",M0";
+        text += ",S";
+        appendRange(text, rule.survivalMin, rule.survivalMax);
+        text += ",B";
+        appendRange(text, rule.birthMin, rule.birthMax);
+        text += rule.neighborhood == Neighborhood::MOORE ? ",NM" : ",NN";
+        return text;
+    }
+
+    std::string text = "B";
+    for (int n = 0; n <= 8; ++n) {
+        if ((rule.birthMask >> n) & 1)
+            text += static_cast<char>('0' + n);
+    }
+    text += "/S";
+    for (int n = 0; n <= 8; ++n) {
+        if ((rule.survivalMask >> n) & 1)
+            text += static_cast<char>('0' + n);
     }
+    if (rule.states > 2)
+        text += "/C" + std::to_string(rule.states);
+    return text;
 }
 
 }  // namespace Core
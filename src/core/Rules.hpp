@@ -2,35 +2,130 @@
  * @file Rules.hpp
  * @brief Definición de reglas de autómatas celulares
  *
- * Diferentes conjuntos de reglas para simulación.
+ * Diferentes conjuntos de reglas para simulación. Cualquier regla totalística
+ * exterior se describe en notación B/S (por ejemplo "B36/S23") y se compila a
+ * una tabla (estado x vecinos) que los kernels indexan sin ramas. Las reglas
+ * Generations ("B2/S345/C4") añaden estados refractarios: una celda viva que no
+ * sobrevive pasa por los estados 2..C-1 antes de morir. Las reglas Larger than
+ * Life ("R5,C0,M1,S34..58,B34..45,NM") usan vecindarios de radio arbitrario y
+ * rangos de nacimiento/supervivencia en lugar de máscaras.
  */
 
 #ifndef RULES_HPP
 #define RULES_HPP
 
 #include "Grid2D.hpp"
+#include <optional>
 #include <string>
 
 namespace Core {
 
 /**
  * @enum RuleType
- * @brief Tipos de reglas disponibles
+ * @brief Tipos de reglas predefinidas
  */
 enum class RuleType {
-    CONWAY,     // Game of Life clásico
-    SEEDS,      // Más caótico
-    HIGHLIFE,   // Game of Life + replicadores
-    DAY_NIGHT,  // Reglas simétricas
-    COUNT
+    CONWAY,        // Game of Life clásico
+    SEEDS,         // Más caótico
+    HIGHLIFE,      // Game of Life + replicadores
+    DAY_NIGHT,     // Reglas simétricas
+    BRIANS_BRAIN,  // Generations B2/S/C3
+    STAR_WARS,     // Generations B2/S345/C4
+    BOSCO,         // Larger than Life R5,C0,M1,S34..58,B34..45,NM
+    COUNT          // También indica "regla personalizada"
 };
 
+/**
+ * @enum Neighborhood
+ * @brief Forma del vecindario de las reglas Larger than Life
+ */
+enum class Neighborhood : uint8_t {
+    MOORE,       // Cuadrado de lado 2r+1
+    VON_NEUMANN  // Rombo |dx| + |dy| <= r
+};
+
+/**
+ * @struct Rule
+ * @brief Regla B/S compilada a tabla de 18 entradas
+ *
+ * La tabla cubre DEAD y ALIVE; los estados refractarios no dependen de los
+ * vecinos y avanzan siempre al siguiente (el último vuelve a DEAD). Las reglas
+ * Larger than Life ignoran máscaras y tabla: usan los rangos [min, max].
+ */
+struct Rule {
+    uint16_t birthMask = 0;     // Bit n activo si una celda muerta nace con n vecinos
+    uint16_t survivalMask = 0;  // Bit n activo si una celda viva sobrevive con n vecinos
+    int states = 2;             // Estados por celda (C en notación Generations)
+    CellState table[2][9] = {};  // [estado][vecinos] -> siguiente estado
+
+    // Larger than Life
+    int radius = 1;                                  // Radio del vecindario
+    Neighborhood neighborhood = Neighborhood::MOORE;  // Forma del vecindario
+    bool includeCenter = false;                      // La celda cuenta como su propia vecina
+    int birthMin = 0, birthMax = -1;                 // Nace con birthMin..birthMax vecinos
+    int survivalMin = 0, survivalMax = -1;           // Sobrevive con survivalMin..survivalMax vecinos
+
+    /**
+     * @brief Verifica si la regla usa rangos (radio > 1 o von Neumann)
+     * @return true para Larger than Life
+     */
+    bool isLargerThanLife() const { return radius > 1 || neighborhood != Neighborhood::MOORE; }
+
+    /**
+     * @brief Aplica la regla a una celda
+     * @param state Estado actual (0 a states-1)
+     * @param neighbors Vecinos vivos (0 a 8)
+     * @return Nuevo estado
+     */
+    CellState apply(CellState state, int neighbors) const
+    {
+        int s = static_cast<int>(state);
+        return s <= 1 ? table[s][neighbors] : static_cast<CellState>((s + 1) % states);
+    }
+
+    bool operator==(const Rule& other) const
+    {
+        return birthMask == other.birthMask && survivalMask == other.survivalMask && states == other.states &&
+               radius == other.radius && neighborhood == other.neighborhood && includeCenter == other.includeCenter &&
+               birthMin == other.birthMin && birthMax == other.birthMax && survivalMin == other.survivalMin &&
+               survivalMax == other.survivalMax;
+    }
+};
+
+/**
+ * @struct StaticRule
+ * @brief Regla con máscaras en tiempo de compilación (los kernels se especializan)
+ */
+template <uint16_t Birth, uint16_t Survival>
+struct StaticRule {
+    static constexpr uint16_t birthMask = Birth;
+    static constexpr uint16_t survivalMask = Survival;
+};
+
+/**
+ * @struct DynamicRule
+ * @brief Regla con máscaras en tiempo de ejecución (reglas personalizadas)
+ */
+struct DynamicRule {
+    uint16_t birthMask;
+    uint16_t survivalMask;
+};
+
+// Reglas predefinidas instanciadas como plantillas
+using ConwayRule = StaticRule<0x008, 0x00C>;    // B3/S23
+using SeedsRule = StaticRule<0x004, 0x000>;     // B2/S
+using HighLifeRule = StaticRule<0x048, 0x00C>;  // B36/S23
+using DayNightRule = StaticRule<0x1C8, 0x1D8>;  // B3678/S34678
+
 /**
  * @class Rules
  * @brief Conjunto de reglas para evolución celular
  */
 class Rules {
 public:
+    // Radio máximo de las reglas Larger than Life
+    static constexpr int MAX_RADIUS = 64;
+
     /**
      * @brief Obtiene el nombre de un tipo de regla
      * @param type Tipo de regla
@@ -39,20 +134,105 @@ public:
     static std::string getName(RuleType type);
 
     /**
-     * @brief Aplica reglas según el tipo
+     * @brief Obtiene el nombre de una regla
+     * @param rule Regla
+     * @return Nombre de la regla predefinida o su notación B/S
+     */
+    static std::string getName(const Rule& rule);
+
+    /**
+     * @brief Compila una regla a partir de sus máscaras
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     * @param states Estados por celda (2 = vida/muerte, más = Generations)
+     * @return Regla con su tabla
+     */
+    static Rule make(uint16_t birthMask, uint16_t survivalMask, int states = 2);
+
+    /**
+     * @brief Crea una regla Larger than Life
+     *
+     * Con radio 1 y vecindario de Moore se convierte a máscaras B/S.
+     *
+     * @param radius Radio del vecindario (1 a MAX_RADIUS)
+     * @param neighborhood Forma del vecindario
+     * @param includeCenter true si la celda cuenta en su propio vecindario
+     * @param birthMin Mínimo de vecinos para nacer
+     * @param birthMax Máximo de vecinos para nacer
+     * @param survivalMin Mínimo de vecinos para sobrevivir
+     * @param survivalMax Máximo de vecinos para sobrevivir
+     * @param states Estados por celda
+     * @return Regla
+     */
+    static Rule makeLargerThanLife(int radius, Neighborhood neighborhood, bool includeCenter, int birthMin,
+                                   int birthMax, int survivalMin, int survivalMax, int states = 2);
+
+    /**
+     * @brief Obtiene una regla predefinida
      * @param type Tipo de regla
-     * @param currentState Estado actual de la celda
-     * @param neighbors Número de vecinos vivos
-     * @return Nuevo estado
+     * @return Regla compilada
+     */
+    static Rule fromType(RuleType type);
+
+    /**
+     * @brief Busca la regla predefinida equivalente
+     * @param rule Regla
+     * @return Tipo, o RuleType::COUNT si es personalizada
+     */
+    static RuleType findType(const Rule& rule);
+
+    /**
+     * @brief Interpreta una regla en notación B/S ("B36/S23", "S23/B3", "23/3",
+     *        "B2/S345/C4" o "345/2/4") o Larger than Life ("R5,C0,M1,S34..58,B34..45,NM")
+     * @param notation Texto de la regla
+     * @return Regla compilada, o std::nullopt si el texto no es válido
+     */
+    static std::optional<Rule> parse(const std::string& notation);
+
+    /**
+     * @brief Escribe una regla en notación B/S
+     * @param rule Regla
+     * @return Texto "B.../S..." (con "/C..." si tiene más de dos estados) o "R...,C...,M...,S...,B...,N..."
      */
-    static CellState apply(RuleType type, CellState currentState, int neighbors);
+    static std::string toNotation(const Rule& rule);
+
+    /**
+     * @brief Llama a f con la regla como StaticRule (predefinidas) o DynamicRule
+     *
+     * Permite que los kernels se instancien una vez por regla predefinida.
+     *
+     * @param birthMask Máscara de nacimiento
+     * @param survivalMask Máscara de supervivencia
+     * @param f Función genérica que recibe la regla
+     * @return Lo que devuelva f
+     */
+    template <typename F>
+    static decltype(auto) visit(uint16_t birthMask, uint16_t survivalMask, F&& f)
+    {
+        if (matches<ConwayRule>(birthMask, survivalMask))
+            return f(ConwayRule{});
+        if (matches<SeedsRule>(birthMask, survivalMask))
+            return f(SeedsRule{});
+        if (matches<HighLifeRule>(birthMask, survivalMask))
+            return f(HighLifeRule{});
+        if (matches<DayNightRule>(birthMask, survivalMask))
+            return f(DayNightRule{});
+        return f(DynamicRule{ birthMask, survivalMask });
+    }
 
 private:
-    // Reglas específicas
-    static CellState conway(CellState current, int neighbors);
-    static CellState seeds(CellState current, int neighbors);
-    static CellState highLife(CellState current, int neighbors);
-    static CellState dayNight(CellState current, int neighbors);
+    /**
+     * @brief Interpreta la notación Larger than Life
+     * @param notation Texto "R...,C...,M...,S...,B...,N..."
+     * @return Regla, o std::nullopt si no es válida
+     */
+    static std::optional<Rule> parseLargerThanLife(const std::string& notation);
+
+    template <typename R>
+    static bool matches(uint16_t birthMask, uint16_t survivalMask)
+    {
+        return birthMask == R::birthMask && survivalMask == R::survivalMask;
+    }
 };
 
 }  // namespace Core
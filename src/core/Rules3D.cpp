@@ -0,0 +1,130 @@
+/**
+ * @file Rules3D.cpp
+ * @brief Implementación de reglas 3D
+ */
+
+#include "Rules3D.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace Core {
+
+Rule3D Rules3D::make(uint32_t birthMask, uint32_t survivalMask, int states, Neighborhood neighborhood)
+{
+    uint32_t valid = (1u << (getNeighborCount(neighborhood) + 1)) - 1;
+    Rule3D rule;
+    rule.birthMask = birthMask & valid;
+    rule.survivalMask = survivalMask & valid;
+    rule.states = std::clamp(states, 2, Grid2D::MAX_STATES);
+    rule.neighborhood = neighborhood;
+    return rule;
+}
+
+std::optional<Rule3D> Rules3D::parse(const std::string& notation)
+{
+    std::string text;
+    for (char c : notation) {
+        if (!std::isspace(static_cast<unsigned char>(c)))
+            text += c;
+    }
+
+    // Bays: cuatro dígitos El Eu Fl Fu (sobrevive con El..Eu, nace con Fl..Fu)
+    if (text.size() == 4 && std::all_of(text.begin(), text.end(), [](char c) { return std::isdigit(c) != 0; })) {
+        auto range = [](int min, int max) { return min > max ? 0u : ((2u << max) - 1) & ~((1u << min) - 1); };
+        return make(range(text[2] - '0', text[3] - '0'), range(text[0] - '0', text[1] - '0'));
+    }
+
+    // Exactamente cuatro campos S/B/C/N
+    std::string fields[4];
+    size_t start = 0;
+    for (int i = 0; i < 4; ++i) {
+        size_t slash = text.find('/', start);
+        if ((slash == std::string::npos) != (i == 3))
+            return std::nullopt;
+        fields[i] = text.substr(start, slash - start);
+        start = slash + 1;
+    }
+
+    Neighborhood neighborhood;
+    if (fields[3] == "M" || fields[3] == "m") {
+        neighborhood = Neighborhood::MOORE;
+    } else if (fields[3] == "N" || fields[3] == "n" || fields[3] == "VN" || fields[3] == "vn") {
+        neighborhood = Neighborhood::VON_NEUMANN;
+    } else {
+        return std::nullopt;
+    }
+    const int maxNeighbors = getNeighborCount(neighborhood);
+
+    auto parseInt = [](const std::string& field, size_t& pos, int& value) {
+        size_t begin = pos;
+        value = 0;
+        while (pos < field.size() && std::isdigit(static_cast<unsigned char>(field[pos])) && pos - begin < 4)
+            value = value * 10 + (field[pos++] - '0');
+        return pos > begin;
+    };
+
+    // Lista separada por comas de valores o rangos "a-b"
+    auto parseList = [&](const std::string& field, uint32_t& mask) {
+        mask = 0;
+        size_t pos = 0;
+        while (pos < field.size()) {
+            int low, high;
+            if (!parseInt(field, pos, low))
+                return false;
+            high = low;
+            if (pos < field.size() && field[pos] == '-') {
+                pos++;
+                if (!parseInt(field, pos, high))
+                    return false;
+            }
+            if (low > high || high > maxNeighbors)
+                return false;
+            for (int n = low; n <= high; ++n)
+                mask |= 1u << n;
+            if (pos < field.size()) {
+                if (field[pos] != ',' || pos + 1 == field.size())
+                    return false;
+                pos++;
+            }
+        }
+        return true;
+    };
+
+    uint32_t survival, birth;
+    if (!parseList(fields[0], survival) || !parseList(fields[1], birth))
+        return std::nullopt;
+
+    size_t pos = 0;
+    int states;
+    if (!parseInt(fields[2], pos, states) || pos != fields[2].size() || states < 2 || states > Grid2D::MAX_STATES)
+        return std::nullopt;
+
+    return make(birth, survival, states, neighborhood);
+}
+
+std::string Rules3D::toNotation(const Rule3D& rule)
+{
+    auto list = [](uint32_t mask) {
+        std::string text;
+        for (int n = 0; n <= 26; ++n) {
+            if (((mask >> n) & 1) == 0)
+                continue;
+            int end = n;
+            while (end < 26 && ((mask >> (end + 1)) & 1))
+                end++;
+            if (!text.empty())
+                text += ',';
+            text += std::to_string(n);
+            if (end > n) {
+                text += '-';
+                text += std::to_string(end);
+            }
+            n = end;
+        }
+        return text;
+    };
+    return list(rule.survivalMask) + "/" + list(rule.birthMask) + "/" + std::to_string(rule.states) + "/" +
+           (rule.neighborhood == Neighborhood::MOORE ? "M" : "N");
+}
+
+}  // namespace Core
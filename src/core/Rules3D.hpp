@@ -0,0 +1,98 @@
+/**
+ * @file Rules3D.hpp
+ * @brief Reglas totalísticas exteriores para autómatas 3D
+ *
+ * Se escriben como "S/B/C/N" ("4/4/5/M": sobrevive con 4, nace con 4,
+ * 5 estados, vecindario de Moore), con listas y rangos ("2,6,9" o "5-7").
+ * También se acepta la notación de Bays de cuatro dígitos ("5766": sobrevive
+ * con 5 a 7 vecinos y nace con 6). El vecindario de Moore tiene 26 celdas y
+ * el de von Neumann 6.
+ */
+
+#ifndef RULES3D_HPP
+#define RULES3D_HPP
+
+#include "Rules.hpp"
+#include <optional>
+#include <string>
+
+namespace Core {
+
+/**
+ * @struct Rule3D
+ * @brief Regla 3D con máscaras de 27 bits (0 a 26 vecinos)
+ *
+ * Con más de dos estados funciona como Generations: la celda viva que no
+ * sobrevive avanza por los estados 2..C-1 antes de morir.
+ */
+struct Rule3D {
+    uint32_t birthMask = 0;     // Bit n activo si una celda muerta nace con n vecinos
+    uint32_t survivalMask = 0;  // Bit n activo si una celda viva sobrevive con n vecinos
+    int states = 2;             // Estados por celda
+    Neighborhood neighborhood = Neighborhood::MOORE;  // MOORE = 26 vecinos, VON_NEUMANN = 6
+
+    /**
+     * @brief Aplica la regla a una celda
+     * @param state Estado actual (0 a states-1)
+     * @param neighbors Vecinos vivos (0 a 26)
+     * @return Nuevo estado
+     */
+    CellState apply(CellState state, int neighbors) const
+    {
+        int s = static_cast<int>(state);
+        if (s == 0)
+            return ((birthMask >> neighbors) & 1) ? CellState::ALIVE : CellState::DEAD;
+        if (s == 1 && ((survivalMask >> neighbors) & 1))
+            return CellState::ALIVE;
+        return static_cast<CellState>((s + 1) % states);
+    }
+
+    bool operator==(const Rule3D& other) const
+    {
+        return birthMask == other.birthMask && survivalMask == other.survivalMask && states == other.states &&
+               neighborhood == other.neighborhood;
+    }
+};
+
+/**
+ * @class Rules3D
+ * @brief Construcción e interpretación de reglas 3D
+ */
+class Rules3D {
+public:
+    /**
+     * @brief Obtiene el número de vecinos de un vecindario 3D
+     * @param neighborhood Forma del vecindario
+     * @return 26 (Moore) o 6 (von Neumann)
+     */
+    static int getNeighborCount(Neighborhood neighborhood) { return neighborhood == Neighborhood::MOORE ? 26 : 6; }
+
+    /**
+     * @brief Crea una regla a partir de sus máscaras
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     * @param states Estados por celda
+     * @param neighborhood Forma del vecindario
+     * @return Regla (las máscaras se recortan al número de vecinos)
+     */
+    static Rule3D make(uint32_t birthMask, uint32_t survivalMask, int states = 2,
+                       Neighborhood neighborhood = Neighborhood::MOORE);
+
+    /**
+     * @brief Interpreta una regla "S/B/C/N" ("4/4/5/M", "2,6,9/4,6,8,9/10/M") o de Bays ("5766")
+     * @param notation Texto de la regla
+     * @return Regla, o std::nullopt si el texto no es válido
+     */
+    static std::optional<Rule3D> parse(const std::string& notation);
+
+    /**
+     * @brief Escribe una regla en notación "S/B/C/N" (rangos consecutivos como "a-b")
+     * @param rule Regla
+     * @return Texto de la regla
+     */
+    static std::string toNotation(const Rule3D& rule);
+};
+
+}  // namespace Core
+
+#endif  // RULES3D_HPP
@@ -0,0 +1,309 @@
+/**
+ * @file SimdKernel.cpp
+ * @brief Implementación del kernel vectorizado con despacho en tiempo de ejecución
+ */
+
+#include "SimdKernel.hpp"
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Core {
+
+namespace {
+
+/**
+ * @brief Procesa las celdas [x0, x1) de una fila
+ *
+ * Requiere que las posiciones x-1 y x+1 sean legibles en las tres filas.
+ * Las tablas tienen 64 bytes: las 16 entradas (índice = vecinos) repetidas
+ * en cada carril de 128 bits, como las espera vpshufb.
+ */
+using RowFunction = void (*)(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out, int x0, int x1,
+                             const uint8_t* birthLut, const uint8_t* survivalLut);
+
+void rowScalar(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out, int x0, int x1,
+               const uint8_t* birthLut, const uint8_t* survivalLut)
+{
+    for (int x = x0; x < x1; ++x) {
+        int count = up[x - 1] + up[x] + up[x + 1] + mid[x - 1] + mid[x + 1] + down[x - 1] + down[x] + down[x + 1];
+        out[x] = mid[x] ? survivalLut[count] : birthLut[count];
+    }
+}
+
+#ifdef SIMD_KERNEL_X86
+
+__attribute__((target("sse2"))) inline __m128i load128(const uint8_t* p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+__attribute__((target("sse2"))) inline void vectorSse2(const uint8_t* up, const uint8_t* mid, const uint8_t* down,
+                                                       uint8_t* out, int x, const uint8_t* birthLut,
+                                                       const uint8_t* survivalLut)
+{
+    __m128i count = _mm_add_epi8(_mm_add_epi8(load128(up + x - 1), load128(up + x)), load128(up + x + 1));
+    count = _mm_add_epi8(count, _mm_add_epi8(load128(mid + x - 1), load128(mid + x + 1)));
+    count = _mm_add_epi8(count, _mm_add_epi8(_mm_add_epi8(load128(down + x - 1), load128(down + x)),
+                                             load128(down + x + 1)));
+
+    // SSE2 no tiene pshufb: la tabla se aplica comparando contra cada conteo
+    __m128i born = _mm_setzero_si128();
+    __m128i keep = _mm_setzero_si128();
+    for (int n = 0; n <= 8; ++n) {
+        if (!birthLut[n] && !survivalLut[n])
+            continue;
+        __m128i eq = _mm_cmpeq_epi8(count, _mm_set1_epi8(static_cast<char>(n)));
+        if (birthLut[n])
+            born = _mm_or_si128(born, eq);
+        if (survivalLut[n])
+            keep = _mm_or_si128(keep, eq);
+    }
+
+    const __m128i one = _mm_set1_epi8(1);
+    __m128i alive = _mm_cmpeq_epi8(load128(mid + x), one);
+    __m128i next = _mm_or_si128(_mm_and_si128(alive, keep), _mm_andnot_si128(alive, born));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_and_si128(next, one));
+}
+
+__attribute__((target("sse2"))) void rowSse2(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out,
+                                             int x0, int x1, const uint8_t* birthLut, const uint8_t* survivalLut)
+{
+    int x = x0;
+    for (; x + 16 <= x1; x += 16) {
+        vectorSse2(up, mid, down, out, x, birthLut, survivalLut);
+    }
+    // Cola: un vector solapado con el anterior (recalcular celdas es idempotente)
+    if (x < x1 && x1 - x0 >= 16) {
+        vectorSse2(up, mid, down, out, x1 - 16, birthLut, survivalLut);
+    } else {
+        rowScalar(up, mid, down, out, x, x1, birthLut, survivalLut);
+    }
+}
+
+__attribute__((target("avx2"))) inline __m256i load256(const uint8_t* p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+__attribute__((target("avx2"))) inline void vectorAvx2(const uint8_t* up, const uint8_t* mid, const uint8_t* down,
+                                                       uint8_t* out, int x, __m256i birth, __m256i survival)
+{
+    __m256i count = _mm256_add_epi8(_mm256_add_epi8(load256(up + x - 1), load256(up + x)), load256(up + x + 1));
+    count = _mm256_add_epi8(count, _mm256_add_epi8(load256(mid + x - 1), load256(mid + x + 1)));
+    count = _mm256_add_epi8(count, _mm256_add_epi8(_mm256_add_epi8(load256(down + x - 1), load256(down + x)),
+                                                   load256(down + x + 1)));
+
+    // Tabla (estado x vecinos): una búsqueda por estado y selección por carril
+    __m256i alive = _mm256_cmpeq_epi8(load256(mid + x), _mm256_set1_epi8(1));
+    __m256i next = _mm256_blendv_epi8(_mm256_shuffle_epi8(birth, count), _mm256_shuffle_epi8(survival, count), alive);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), next);
+}
+
+__attribute__((target("avx2"))) void rowAvx2(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out,
+                                             int x0, int x1, const uint8_t* birthLut, const uint8_t* survivalLut)
+{
+    const __m256i birth = load256(birthLut);
+    const __m256i survival = load256(survivalLut);
+    int x = x0;
+    for (; x + 32 <= x1; x += 32) {
+        vectorAvx2(up, mid, down, out, x, birth, survival);
+    }
+    if (x < x1 && x1 - x0 >= 32) {
+        vectorAvx2(up, mid, down, out, x1 - 32, birth, survival);
+    } else {
+        rowSse2(up, mid, down, out, x, x1, birthLut, survivalLut);
+    }
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline __m512i maskedLoad512(__mmask64 lanes, const uint8_t* p)
+{
+    return _mm512_maskz_loadu_epi8(lanes, p);
+}
+
+__attribute__((target("avx512f,avx512bw"))) void rowAvx512(const uint8_t* up, const uint8_t* mid, const uint8_t* down,
+                                                           uint8_t* out, int x0, int x1, const uint8_t* birthLut,
+                                                           const uint8_t* survivalLut)
+{
+    const __m512i one = _mm512_set1_epi8(1);
+    const __m512i birth = _mm512_loadu_si512(birthLut);
+    const __m512i survival = _mm512_loadu_si512(survivalLut);
+
+    // La cola se resuelve con cargas/escrituras enmascaradas
+    for (int x = x0; x < x1; x += 64) {
+        __mmask64 lanes = (x1 - x >= 64) ? ~0ULL : (1ULL << (x1 - x)) - 1;
+        __m512i upLeft = maskedLoad512(lanes, up + x - 1);
+        __m512i count = _mm512_add_epi8(_mm512_add_epi8(upLeft, maskedLoad512(lanes, up + x)),
+                                        maskedLoad512(lanes, up + x + 1));
+        count = _mm512_add_epi8(count, maskedLoad512(lanes, mid + x - 1));
+        count = _mm512_add_epi8(count, maskedLoad512(lanes, mid + x + 1));
+        count = _mm512_add_epi8(count, maskedLoad512(lanes, down + x - 1));
+        count = _mm512_add_epi8(count, maskedLoad512(lanes, down + x));
+        count = _mm512_add_epi8(count, maskedLoad512(lanes, down + x + 1));
+
+        __mmask64 alive = _mm512_cmpeq_epi8_mask(maskedLoad512(lanes, mid + x), one);
+        __m512i next = _mm512_mask_blend_epi8(alive, _mm512_shuffle_epi8(birth, count),
+                                              _mm512_shuffle_epi8(survival, count));
+        _mm512_mask_storeu_epi8(out + x, lanes, next);
+    }
+}
+
+#endif  // SIMD_KERNEL_X86
+
+const RowFunction ROW_FUNCTIONS[] = {
+    rowScalar,
+#ifdef SIMD_KERNEL_X86
+    rowSse2,
+    rowAvx2,
+    rowAvx512,
+#endif
+};
+
+std::atomic<SimdKernel::Isa>& activeIsa()
+{
+    static std::atomic<SimdKernel::Isa> isa(SimdKernel::Isa::COUNT);
+    return isa;
+}
+
+/**
+ * @brief Fila con una regla Generations: solo el estado 1 cuenta como vecino
+ */
+void rowGenerations(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out, int x0, int x1,
+                    const Rule& rule)
+{
+    for (int x = x0; x < x1; ++x) {
+        int count = (up[x - 1] == 1) + (up[x] == 1) + (up[x + 1] == 1) + (mid[x - 1] == 1) + (mid[x + 1] == 1) +
+                    (down[x - 1] == 1) + (down[x] == 1) + (down[x + 1] == 1);
+        out[x] = static_cast<uint8_t>(rule.apply(static_cast<CellState>(mid[x]), count));
+    }
+}
+
+/**
+ * @brief Compara la fila calculada con la anterior mientras sigue en L1
+ *
+ * Con SSE2 (siempre disponible en x86-64) las comparaciones de 16 bytes se
+ * acumulan por byte (-1 por coincidencia) y se suman con psadbw cada 255 vectores.
+ */
+void countRow(const uint8_t* before, const uint8_t* after, int x0, int x1, StepCounts& counts)
+{
+    int x = x0;
+#ifdef SIMD_KERNEL_X86
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i zero = _mm_setzero_si128();
+    auto total = [&](__m128i sums) {
+        __m128i sad = _mm_sad_epu8(_mm_sub_epi8(zero, sums), zero);
+        return _mm_cvtsi128_si64(sad) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sad, sad));
+    };
+    while (x + 16 <= x1) {
+        __m128i births = zero, deaths = zero, same = zero;
+        for (int n = 0; n < 255 && x + 16 <= x1; ++n, x += 16) {
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(before + x));
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(after + x));
+            __m128i wasAlive = _mm_cmpeq_epi8(b, one);
+            __m128i isAlive = _mm_cmpeq_epi8(a, one);
+            births = _mm_add_epi8(births, _mm_andnot_si128(wasAlive, isAlive));
+            deaths = _mm_add_epi8(deaths, _mm_andnot_si128(isAlive, wasAlive));
+            same = _mm_add_epi8(same, _mm_cmpeq_epi8(a, b));
+        }
+        counts.births += total(births);
+        counts.deaths += total(deaths);
+        counts.changed -= total(same);
+        counts.changed += x - x0;
+        x0 = x;
+    }
+#endif
+    for (; x < x1; ++x) {
+        bool wasAlive = before[x] == 1;
+        bool isAlive = after[x] == 1;
+        counts.births += isAlive && !wasAlive;
+        counts.deaths += wasAlive && !isAlive;
+        counts.changed += before[x] != after[x];
+    }
+}
+
+}  // namespace
+
+SimdKernel::Isa SimdKernel::detectIsa()
+{
+#ifdef SIMD_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw"))
+        return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return Isa::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return Isa::SSE2;
+#endif
+    return Isa::SCALAR;
+}
+
+SimdKernel::Isa SimdKernel::getIsa()
+{
+    Isa isa = activeIsa().load(std::memory_order_relaxed);
+    if (isa == Isa::COUNT) {
+        isa = detectIsa();
+        activeIsa().store(isa, std::memory_order_relaxed);
+    }
+    return isa;
+}
+
+void SimdKernel::setIsa(Isa isa)
+{
+    Isa best = detectIsa();
+    activeIsa().store(static_cast<int>(isa) < static_cast<int>(best) ? isa : best, std::memory_order_relaxed);
+}
+
+const char* SimdKernel::getIsaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::SCALAR:
+        return "Scalar";
+    case Isa::SSE2:
+        return "SSE2";
+    case Isa::AVX2:
+        return "AVX2";
+    case Isa::AVX512:
+        return "AVX-512";
+    default:
+        return "Unknown";
+    }
+}
+
+StepCounts SimdKernel::stepRows(const Grid2D& grid, CellState* out, int y0, int y1, int x0, int x1, const Rule& rule)
+{
+    // Tablas de 16 entradas (índice = vecinos), repetidas por carril de 128 bits
+    alignas(64) uint8_t birthLut[64] = {};
+    alignas(64) uint8_t survivalLut[64] = {};
+    for (int i = 0; i < 64; ++i) {
+        int n = i & 15;
+        birthLut[i] = n <= 8 ? static_cast<uint8_t>(rule.table[0][n]) : 0;
+        survivalLut[i] = n <= 8 ? static_cast<uint8_t>(rule.table[1][n]) : 0;
+    }
+
+    RowFunction rowFunction = ROW_FUNCTIONS[static_cast<int>(getIsa())];
+    StepCounts counts;
+
+    for (int y = y0; y < y1; ++y) {
+        // El halo del grid da los vecinos del borde: la fila entera va vectorizada
+        const uint8_t* up = reinterpret_cast<const uint8_t*>(grid.getByteRow(y - 1));
+        const uint8_t* mid = reinterpret_cast<const uint8_t*>(grid.getByteRow(y));
+        const uint8_t* down = reinterpret_cast<const uint8_t*>(grid.getByteRow(y + 1));
+        uint8_t* dst = reinterpret_cast<uint8_t*>(out) + grid.getByteOffset(y);
+
+        // Los estados refractarios no caben en la suma de bytes: ruta escalar
+        if (rule.states > 2) {
+            rowGenerations(up, mid, down, dst, x0, x1, rule);
+        } else {
+            rowFunction(up, mid, down, dst, x0, x1, birthLut, survivalLut);
+        }
+
+        countRow(mid, dst, x0, x1, counts);
+    }
+
+    return counts;
+}
+
+}  // namespace Core
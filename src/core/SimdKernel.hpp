@@ -0,0 +1,80 @@
+/**
+ * @file SimdKernel.hpp
+ * @brief Kernel vectorizado para el layout de un byte por celda
+ *
+ * Suma las tres filas desplazadas con 16/32/64 carriles a la vez y aplica la
+ * regla con una tabla de búsqueda (shuffle). El conjunto de instrucciones se
+ * detecta en tiempo de ejecución, con una ruta escalar de respaldo. Las reglas
+ * Generations usan siempre la ruta escalar.
+ */
+
+#ifndef SIMD_KERNEL_HPP
+#define SIMD_KERNEL_HPP
+
+#include "Grid2D.hpp"
+#include "Rules.hpp"
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * @class SimdKernel
+ * @brief Paso de autómatas totalísticos sobre el layout GridLayout::BYTES
+ */
+class SimdKernel {
+public:
+    /**
+     * @enum Isa
+     * @brief Conjuntos de instrucciones soportados (de menor a mayor)
+     */
+    enum class Isa {
+        SCALAR,
+        SSE2,    // 16 carriles
+        AVX2,    // 32 carriles
+        AVX512,  // 64 carriles (AVX-512BW)
+        COUNT
+    };
+
+    /**
+     * @brief Obtiene el conjunto de instrucciones en uso
+     * @return El mejor detectado por cpuid, salvo que setIsa() lo limite
+     */
+    static Isa getIsa();
+
+    /**
+     * @brief Limita el conjunto de instrucciones (para comparar rutas)
+     * @param isa Conjunto deseado; se recorta al máximo soportado por la CPU
+     */
+    static void setIsa(Isa isa);
+
+    /**
+     * @brief Obtiene el nombre de un conjunto de instrucciones
+     * @param isa Conjunto de instrucciones
+     * @return Nombre legible
+     */
+    static const char* getIsaName(Isa isa);
+
+    /**
+     * @brief Calcula el rectángulo [x0, x1) x [y0, y1) de la siguiente generación
+     * @param grid Grid de origen (layout BYTES, halo actualizado)
+     * @param out Buffer destino con la forma de grid.getByteData()
+     * @param y0 Primera fila
+     * @param y1 Fila final (exclusiva)
+     * @param x0 Primera columna
+     * @param x1 Columna final (exclusiva)
+     * @param rule Regla compilada (su tabla se replica en los registros de shuffle)
+     * @return Nacimientos, muertes y celdas cambiadas en el rectángulo
+     */
+    static StepCounts stepRows(const Grid2D& grid, CellState* out, int y0, int y1, int x0, int x1, const Rule& rule);
+
+private:
+    /**
+     * @brief Detecta el mejor conjunto de instrucciones de la CPU
+     * @return Conjunto detectado
+     */
+    static Isa detectIsa();
+};
+
+}  // namespace Core
+
+#endif  // SIMD_KERNEL_HPP
@@ -0,0 +1,151 @@
+/**
+ * @file SimulationThread.cpp
+ * @brief Implementación de SimulationThread
+ */
+
+#include "SimulationThread.hpp"
+#include <chrono>
+
+namespace Core {
+
+namespace {
+
+// Pausa del bucle cuando no tocaba ningún paso (el Simulator acumula el tiempo)
+const std::chrono::microseconds IDLE_SLEEP(500);
+
+// Intervalo de la medida del ritmo
+const float RATE_INTERVAL = 0.5f;
+
+}  // namespace
+
+SimulationThread::SimulationThread(Simulator& simulator, Grid2D& grid) :
+    simulator(simulator), grid(grid), running(false), rateTimer(0.0f), rateGeneration(simulator.getGeneration()),
+    generationsPerSecond(0.0f)
+{
+    // El render tiene una instantánea válida desde el primer frame
+    publish();
+    snapshots.acquire();
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start()
+{
+    if (thread.joinable())
+        return;
+    running.store(true, std::memory_order_release);
+    thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop()
+{
+    if (!thread.joinable())
+        return;
+    running.store(false, std::memory_order_release);
+    thread.join();
+}
+
+bool SimulationThread::submit(Command command)
+{
+    return commands.push(std::move(command));
+}
+
+void SimulationThread::run()
+{
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point last = Clock::now();
+    bool changed = false;
+
+    while (running.load(std::memory_order_acquire)) {
+        Command command;
+        while (commands.pop(command)) {
+            command(simulator, grid);
+            changed = true;
+        }
+
+        Clock::time_point now = Clock::now();
+        float deltaTime = std::chrono::duration<float>(now - last).count();
+        last = now;
+
+        int64_t generation = simulator.getGeneration();
+        simulator.update(deltaTime);
+        bool stepped = simulator.getGeneration() != generation;
+        changed |= stepped;
+        changed |= measureRate(deltaTime);
+
+        // Solo se prepara otra instantánea cuando el render ya tomó la anterior; mientras tanto la
+        // simulación sigue avanzando y la siguiente sale con el estado más reciente
+        if (changed && snapshots.isConsumed()) {
+            publish();
+            changed = false;
+        }
+
+        // Con un paso a medias se sigue calculando sin pausa: solo se parte para atender órdenes
+        if (!stepped && !simulator.isStepPending())
+            std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+bool SimulationThread::measureRate(float deltaTime)
+{
+    rateTimer += deltaTime;
+    if (rateTimer < RATE_INTERVAL)
+        return false;
+    generationsPerSecond = static_cast<float>(simulator.getGeneration() - rateGeneration) / rateTimer;
+    rateGeneration = simulator.getGeneration();
+    rateTimer = 0.0f;
+    return true;
+}
+
+void SimulationThread::publish()
+{
+    SimulationSnapshot& snapshot = snapshots.getWriteBuffer();
+
+    // Con Lenia el grid solo guarda el umbral y se pinta el campo continuo
+    const Lenia& lenia = simulator.getLenia();
+    bool showField = simulator.getEngine() == EngineType::LENIA && lenia.getWidth() == grid.getWidth() &&
+                     lenia.getHeight() == grid.getHeight();
+    if (showField) {
+        palette.renderField(lenia.getField(), lenia.getWidth(), lenia.getHeight(), snapshot.pixels);
+    } else {
+        palette.render(grid, snapshot.pixels);
+    }
+    snapshot.width = grid.getWidth();
+    snapshot.height = grid.getHeight();
+    snapshot.revision = grid.getRevision();
+
+    snapshot.generation = simulator.getGeneration();
+    snapshot.population = grid.getPopulation();
+    snapshot.lastStep = grid.getLastStep();
+    snapshot.cycle = simulator.getCycle();
+    snapshot.activeTiles = simulator.getActiveTileCount();
+    snapshot.tileCount = grid.getTilesX() * grid.getTilesY();
+    snapshot.generationsPerSecond = generationsPerSecond;
+    snapshot.updateReport = simulator.getUpdateReport();
+
+    snapshot.rule = simulator.getRule();
+    snapshot.boundary = simulator.getBoundary();
+    snapshot.engine = simulator.getEngine();
+    snapshot.paused = simulator.isPaused();
+    snapshot.autoFastForward = simulator.isAutoFastForward();
+    snapshot.stepsPerPass = simulator.getStepsPerPass();
+    snapshot.slicedStepping = simulator.isSlicedStepping();
+    snapshot.stepProgress = simulator.getStepProgress();
+    snapshot.stepBudget = simulator.getStepBudget();
+    HashLife& hashLife = simulator.getHashLife();
+    snapshot.hashLifeStepLog2 = hashLife.getStepLog2();
+    snapshot.hashLifeNodes = hashLife.getNodeCount();
+    snapshot.hashLifeMemory = hashLife.getMemoryUsage();
+    SparseUniverse& sparse = simulator.getSparseUniverse();
+    snapshot.sparseChunks = sparse.getChunkCount();
+    snapshot.sparseMemory = sparse.getMemoryUsage();
+    snapshot.sparsePopulation = sparse.getPopulation();
+    snapshot.leniaRule = lenia.getRule();
+
+    snapshots.publish();
+}
+
+}  // namespace Core
@@ -0,0 +1,170 @@
+/**
+ * @file SimulationThread.hpp
+ * @brief Simulación en un hilo propio, desacoplada del render
+ *
+ * El hilo avanza el Simulator con su propio reloj, así que el ritmo de la
+ * simulación no depende del refresco de pantalla y una generación lenta no
+ * detiene el render. El resultado se publica en instantáneas (imagen RGBA,
+ * contadores y ajustes actuales) a través de un TripleBuffer; los cambios
+ * que pide la UI viajan en sentido contrario como órdenes en una SpscQueue.
+ * Ninguno de los dos hilos espera nunca al otro.
+ */
+
+#ifndef SIMULATION_THREAD_HPP
+#define SIMULATION_THREAD_HPP
+
+#include "CellPalette.hpp"
+#include "CycleDetector.hpp"
+#include "Grid2D.hpp"
+#include "Lenia.hpp"
+#include "Rules.hpp"
+#include "Simulator.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @struct SimulationSnapshot
+ * @brief Estado publicado de la simulación: lo que leen el render, Stats y la UI
+ */
+struct SimulationSnapshot {
+    // Imagen del grid (ver CellPalette) y revisión del grid que representa
+    std::vector<uint8_t> pixels;
+    int width = 0;
+    int height = 0;
+    uint64_t revision = 0;
+
+    // Contadores
+    int64_t generation = 0;
+    int64_t population = 0;
+    StepCounts lastStep;
+    CycleInfo cycle;
+    int activeTiles = 0;
+    int tileCount = 0;
+    float generationsPerSecond = 0.0f;  // Medido en el hilo de simulación
+    UpdateReport updateReport;          // Pasos aplazados y descartados por el presupuesto
+
+    // Ajustes actuales (los widgets muestran estos valores)
+    Rule rule;
+    BoundaryMode boundary = BoundaryMode::DEAD;
+    EngineType engine = EngineType::GRID;
+    bool paused = false;
+    bool autoFastForward = true;
+    int stepsPerPass = 1;
+    bool slicedStepping = false;
+    float stepProgress = 0.0f;  // Fracción calculada del paso a medias (ver Simulator::stepFor)
+    StepBudget stepBudget;
+    int hashLifeStepLog2 = 0;
+    size_t hashLifeNodes = 0;
+    size_t hashLifeMemory = 0;
+    size_t sparseChunks = 0;
+    size_t sparseMemory = 0;
+    uint64_t sparsePopulation = 0;
+    LeniaRule leniaRule;
+};
+
+/**
+ * @class SimulationThread
+ * @brief Hilo que avanza un Simulator y publica instantáneas sin bloqueos
+ */
+class SimulationThread {
+public:
+    // Orden ejecutada en el hilo de simulación entre dos actualizaciones
+    using Command = std::function<void(Simulator& simulator, Grid2D& grid)>;
+
+    // Tamaño de la cola de órdenes (la UI genera unas pocas por frame)
+    static constexpr size_t COMMAND_CAPACITY = 256;
+
+    /**
+     * @brief Constructor (publica la primera instantánea; el hilo no arranca)
+     * @param simulator Simulador (solo lo toca este hilo mientras está en marcha)
+     * @param grid Grid del simulador
+     */
+    SimulationThread(Simulator& simulator, Grid2D& grid);
+
+    /**
+     * @brief Destructor - Detiene y une el hilo
+     */
+    ~SimulationThread();
+
+    // Prevenir copia
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * @brief Arranca el hilo de simulación
+     */
+    void start();
+
+    /**
+     * @brief Detiene el hilo (las órdenes pendientes se descartan)
+     */
+    void stop();
+
+    /**
+     * @brief Verifica si el hilo está en marcha
+     * @return true entre start() y stop()
+     */
+    bool isRunning() const { return thread.joinable(); }
+
+    /**
+     * @brief Pide un cambio al simulador (hilo del render, no espera)
+     * @param command Orden a ejecutar en el hilo de simulación
+     * @return false si la cola estaba llena y la orden se descartó
+     */
+    bool submit(Command command);
+
+    /**
+     * @brief Toma la última instantánea publicada (hilo del render, no espera)
+     * @return true si getSnapshot() cambió
+     */
+    bool acquireSnapshot() { return snapshots.acquire(); }
+
+    /**
+     * @brief Última instantánea tomada con acquireSnapshot()
+     * @return Instantánea (válida hasta el siguiente acquireSnapshot())
+     */
+    const SimulationSnapshot& getSnapshot() const { return snapshots.getReadBuffer(); }
+
+private:
+    Simulator& simulator;
+    Grid2D& grid;
+    CellPalette palette;
+
+    TripleBuffer<SimulationSnapshot> snapshots;
+    SpscQueue<Command, COMMAND_CAPACITY> commands;
+    std::atomic<bool> running;
+    std::thread thread;
+
+    // Ritmo medido (solo hilo de simulación)
+    float rateTimer;
+    int64_t rateGeneration;
+    float generationsPerSecond;
+
+    /**
+     * @brief Bucle del hilo: órdenes, actualización y publicación
+     */
+    void run();
+
+    /**
+     * @brief Rellena y publica una instantánea del estado actual
+     */
+    void publish();
+
+    /**
+     * @brief Actualiza el ritmo medido en generaciones por segundo
+     * @param deltaTime Tiempo desde la última llamada
+     * @return true si se renovó la medida (cada medio segundo)
+     */
+    bool measureRate(float deltaTime);
+};
+
+}  // namespace Core
+
+#endif  // SIMULATION_THREAD_HPP
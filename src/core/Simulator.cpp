@@ -4,58 +4,732 @@
  */
 
 #include "Simulator.hpp"
+#include "BitKernel.hpp"
+#include "SimdKernel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
 
 namespace Core {
 
+// Tiles (palabras) por bloque de la pasada con bloqueo temporal: el halo de una palabra a cada lado
+// añade 2/8 de trabajo y el bloque de paso sigue cabiendo en L1/L2 con halos de hasta 64 filas
+static const int PASS_BLOCK_TILES = 16;
+
+// Tiles del primer trozo de stepFor() (y mínimo de cada trozo): el coste de los siguientes se estima con
+// el medido, y un trozo menor no compensa repartirlo entre los hilos
+static const int SLICE_MIN_TILES = 64;
+static const int SLICE_MIN_ROWS = 8;  // Ídem en filas de tiles para el registro de ciclos
+
+namespace {
+
+// Elementos del siguiente trozo de stepFor(): los que caben en el tiempo que queda según el coste medido
+int sliceChunk(int left, int minimum, float remaining, bool limited, float millisecondsPerItem)
+{
+    if (!limited)
+        return left;
+    int chunk = millisecondsPerItem > 0.0f ? static_cast<int>(remaining / millisecondsPerItem) : minimum;
+    return std::clamp(chunk, std::min(minimum, left), left);
+}
+
+}  // namespace
+
 Simulator::Simulator(Grid2D& grid) :
-    grid(grid), paused(true), updateInterval(0.1f), accumulator(0.0f), currentRule(RuleType::CONWAY), generation(0)
+    grid(grid), paused(true), updateInterval(0.1f), accumulator(0.0f), currentRule(Rules::fromType(RuleType::CONWAY)),
+    generation(0), stepsPerPass(1),
+    pool(std::make_unique<ThreadPool>()), tileFlagGenerations(1), engine(EngineType::GRID), engineRevision(UINT64_MAX),
+    cycleRevision(UINT64_MAX), autoFastForward(true), slicedStepping(false)
 {
+    resizeBlockScratch();
 }
 
 void Simulator::step()
 {
-    int width = grid.getWidth();
-    int height = grid.getHeight();
+    // El paso entero parte del grid visible: lo que stepFor() dejó a medias ya no vale
+    slice.pending = false;
+
+    if (!stepsOnGrid()) {
+        if (engine == EngineType::LENIA) {
+            stepLenia();
+        } else if (engine == EngineType::HASHLIFE) {
+            stepHashLife();
+        } else {
+            stepSparse();
+        }
+        return;
+    }
+
+    // Ediciones desde el último registro: los estados anteriores ya no llevan al actual
+    if (grid.getRevision() != cycleRevision)
+        cycleDetector.reset();
+
+    if (currentRule.isLargerThanLife()) {
+        stepLargerThanLife();
+    } else if (stepsPerPass > 1 && grid.getLayout() == GridLayout::BITS) {
+        stepBitsBlocked();
+    } else {
+        for (int i = 0; i < stepsPerPass; ++i)
+            stepGrid();
+    }
+
+    recordCycle();
+}
+
+bool Simulator::stepFor(float milliseconds)
+{
+    if (!stepsOnGrid() || currentRule.isLargerThanLife()) {
+        step();
+        return true;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    auto elapsedSince = [](Clock::time_point from) {
+        return std::chrono::duration<float, std::milli>(Clock::now() - from).count();
+    };
+
+    // Una edición, otra regla u otro paso entre medias dejan sin valor lo calculado
+    if (slice.pending &&
+        (slice.revision != grid.getRevision() || slice.generation != generation || !(slice.rule == currentRule)))
+        slice.pending = false;
+    if (!slice.pending) {
+        if (grid.getRevision() != cycleRevision)
+            cycleDetector.reset();
+        slice.generationsLeft = stepsPerPass;
+        beginSlicedGeneration();
+    }
 
-    // Crear buffer temporal para el nuevo estado
-    std::vector<CellState> newStates(width * height);
+    bool progressed = false;
+    while (!slice.hashing) {
+        const int total = static_cast<int>(activeTiles.size());
+        while (slice.cursor < total) {
+            float elapsed = elapsedSince(start);
+            if (milliseconds > 0.0f && progressed && elapsed >= milliseconds)
+                return false;
+            int chunk = sliceChunk(total - slice.cursor, SLICE_MIN_TILES, milliseconds - elapsed,
+                                   milliseconds > 0.0f, slice.millisecondsPerTile);
+            const Clock::time_point chunkStart = Clock::now();
+            slice.counts += stepActiveTiles(slice.cursor, slice.cursor + chunk);
+            slice.millisecondsPerTile = elapsedSince(chunkStart) / static_cast<float>(chunk);
+            slice.cursor += chunk;
+            progressed = true;
+        }
 
-    // Calcular nuevo estado para cada celda
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int neighbors = grid.countAliveNeighbors(x, y);
-            CellState currentState = grid.getCell(x, y);
-            newStates[y * width + x] = Rules::apply(currentRule, currentState, neighbors);
+        // Generación completa: el grid pasa a ella de una vez
+        commitGeneration(slice.counts);
+        progressed = true;
+        if (--slice.generationsLeft > 0) {
+            beginSlicedGeneration();
+            continue;
         }
+
+        // El registro de ciclos también va por trozos (el grid ya muestra la generación nueva)
+        cycleDetector.beginRecord(grid);
+        slice.hashing = true;
+        slice.cursor = 0;
+        slice.revision = grid.getRevision();
+        slice.generation = generation;
+    }
+
+    const int tilesY = grid.getTilesY();
+    while (slice.cursor < tilesY) {
+        float elapsed = elapsedSince(start);
+        if (milliseconds > 0.0f && progressed && elapsed >= milliseconds)
+            return false;
+        int chunk = sliceChunk(tilesY - slice.cursor, SLICE_MIN_ROWS, milliseconds - elapsed, milliseconds > 0.0f,
+                               slice.millisecondsPerRow);
+        const Clock::time_point chunkStart = Clock::now();
+        cycleDetector.recordRows(grid, slice.cursor, slice.cursor + chunk, bandPool());
+        slice.millisecondsPerRow = elapsedSince(chunkStart) / static_cast<float>(chunk);
+        slice.cursor += chunk;
+        progressed = true;
+    }
+    cycleDetector.finishRecord(grid, generation);
+    cycleRevision = grid.getRevision();
+    slice.pending = false;
+    return true;
+}
+
+float Simulator::getStepProgress() const
+{
+    if (!slice.pending || stepsPerPass <= 0)
+        return 0.0f;
+    if (slice.hashing)
+        return 1.0f;
+    float generationDone = 0.0f;
+    if (!activeTiles.empty())
+        generationDone = static_cast<float>(slice.cursor) / static_cast<float>(activeTiles.size());
+    float passDone = static_cast<float>(stepsPerPass - slice.generationsLeft) + generationDone;
+    return std::clamp(passDone / static_cast<float>(stepsPerPass), 0.0f, 1.0f);
+}
+
+void Simulator::beginSlicedGeneration()
+{
+    beginGeneration();
+    slice.pending = true;
+    slice.hashing = false;
+    slice.cursor = 0;
+    slice.counts = StepCounts {};
+    slice.revision = grid.getRevision();
+    slice.generation = generation;
+    slice.rule = currentRule;
+}
+
+void Simulator::recordCycle()
+{
+    cycleDetector.record(grid, generation, bandPool());
+    cycleRevision = grid.getRevision();
+}
+
+bool Simulator::stepsOnGrid() const
+{
+    if (engine == EngineType::LENIA)
+        return false;
+    if (currentRule.isLargerThanLife())
+        return true;
+
+    // Los motores de plano infinito solo manejan reglas de dos estados
+    uint16_t birthMask = currentRule.birthMask;
+    bool twoState = currentRule.states == 2;
+    if (engine == EngineType::HASHLIFE && twoState && HashLife::supportsRule(birthMask))
+        return false;
+    if (engine == EngineType::SPARSE && twoState && SparseUniverse::supportsRule(birthMask))
+        return false;
+    return true;
+}
+
+void Simulator::stepSingleGeneration()
+{
+    if (currentRule.isLargerThanLife()) {
+        grid.setLastStep(largerThanLife.step(grid, currentRule, bandPool()));
+        generation++;
+    } else {
+        stepGrid();
+    }
+}
+
+bool Simulator::fastForward(int64_t targetGeneration)
+{
+    const CycleInfo& cycle = cycleDetector.getCycle();
+    if (!cycle.isDetected() || !stepsOnGrid() || grid.getRevision() != cycleRevision || targetGeneration < generation)
+        return false;
+
+    // Los periodos completos no cambian el estado; solo se simula el resto
+    slice.pending = false;
+    int64_t remainder = (targetGeneration - generation) % cycle.period;
+    int64_t skipped = targetGeneration - generation - remainder;
+    cycleDetector.advance(skipped);
+    generation += skipped;
+
+    for (int64_t i = 0; i < remainder; ++i) {
+        stepSingleGeneration();
+        recordCycle();
+    }
+    return true;
+}
+
+void Simulator::prepareTileFlags(int generations)
+{
+    if (tileFlagGenerations == generations)
+        return;
+    grid.markAllTilesChanged();
+    tileFlagGenerations = generations;
+}
+
+void Simulator::stepGrid()
+{
+    beginGeneration();
+    commitGeneration(stepActiveTiles(0, static_cast<int>(activeTiles.size())));
+}
+
+void Simulator::beginGeneration()
+{
+    // Los kernels leen los vecinos del borde del halo, sin comprobar límites
+    grid.refreshHalo();
+
+    // Solo se recalculan los tiles con cambios en su vecindario 3x3
+    prepareTileFlags(1);
+    collectActiveTiles();
+    nextTileChanges.assign(static_cast<size_t>(grid.getTilesX()) * grid.getTilesY(), 0);
+}
+
+StepCounts Simulator::stepActiveTiles(int begin, int end)
+{
+    if (grid.getLayout() == GridLayout::BITS)
+        return stepBits(begin, end);
+    if (grid.getLayout() == GridLayout::TILED)
+        return stepTiled(begin, end);
+    return stepBytes(begin, end);
+}
+
+void Simulator::commitGeneration(const StepCounts& counts)
+{
+    grid.swapBuffers(counts);
+    grid.swapTileChanges(nextTileChanges);
+    generation++;
+}
+
+void Simulator::stepHashLife()
+{
+    hashLife.setRule(currentRule.birthMask, currentRule.survivalMask);
+    if (grid.getRevision() != engineRevision) {
+        hashLife.loadFromGrid(grid);
+    }
+
+    hashLife.step();
+    hashLife.storeToGrid(grid);
+    // Avanza 2^k generaciones: solo la población (mantenida por el grid) tiene sentido
+    grid.setLastStep(StepCounts{});
+    engineRevision = grid.getRevision();
+    generation += int64_t(1) << hashLife.getStepLog2();
+}
+
+void Simulator::stepSparse()
+{
+    sparse.setRule(currentRule.birthMask, currentRule.survivalMask);
+    if (grid.getRevision() != engineRevision) {
+        sparse.loadFromGrid(grid);
     }
 
-    // Aplicar nuevo estado al grid
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            grid.setCell(x, y, newStates[y * width + x]);
+    sparse.step(pool.get());
+    sparse.storeToGrid(grid);
+    // El universo sigue fuera de la ventana: solo se conoce la población de la ventana
+    grid.setLastStep(StepCounts{});
+    engineRevision = grid.getRevision();
+    generation++;
+}
+
+void Simulator::stepLenia()
+{
+    if (grid.getRevision() != engineRevision) {
+        lenia.loadFromGrid(grid);
+    }
+
+    lenia.step(grid.getBoundary(), bandPool());
+    lenia.storeToGrid(grid);
+    // Los estados son continuos: nacimientos y muertes del umbral no describen el paso
+    grid.setLastStep(StepCounts{});
+    engineRevision = grid.getRevision();
+    generation++;
+}
+
+void Simulator::randomizeLenia(float density, uint64_t seed)
+{
+    lenia.randomize(grid.getWidth(), grid.getHeight(), density, seed);
+    lenia.storeToGrid(grid);
+    grid.setLastStep(StepCounts{});
+    engineRevision = grid.getRevision();
+    generation = 0;
+}
+
+void Simulator::stepLargerThanLife()
+{
+    for (int i = 0; i < stepsPerPass; ++i) {
+        grid.setLastStep(largerThanLife.step(grid, currentRule, bandPool()));
+        generation++;
+    }
+}
+
+void Simulator::setEngine(EngineType type)
+{
+    engine = type;
+    // El nuevo motor debe partir del contenido actual del grid
+    engineRevision = UINT64_MAX;
+}
+
+StepCounts Simulator::stepBytes(int begin, int end)
+{
+    // Se escribe en el buffer trasero; los tiles inactivos ya coinciden con el frontal
+    CellState* newStates = grid.getBackByteData();
+
+    // Stencil vectorizado (SSE2/AVX2/AVX-512 según la CPU)
+    return forEachActiveTile([&](int tx, int ty) {
+        int x0 = tx * Grid2D::TILE_SIZE;
+        int y0 = ty * Grid2D::TILE_SIZE;
+        int x1 = std::min(x0 + Grid2D::TILE_SIZE, grid.getWidth());
+        int y1 = std::min(y0 + Grid2D::TILE_SIZE, grid.getHeight());
+        return SimdKernel::stepRows(grid, newStates, y0, y1, x0, x1, currentRule);
+    }, begin, end);
+}
+
+StepCounts Simulator::stepBits(int begin, int end)
+{
+    // 64 celdas por palabra con sumadores bit-slice; un tile = una palabra de ancho
+    uint64_t* next = grid.getBackBitData();
+    uint16_t birthMask = currentRule.birthMask;
+    uint16_t survivalMask = currentRule.survivalMask;
+    bool generations = currentRule.states > 2;
+
+    static_assert(Grid2D::TILE_SIZE == 64, "BitKernel asume tiles de una palabra de ancho");
+    return forEachActiveTile([&](int tx, int ty) {
+        int y0 = ty * Grid2D::TILE_SIZE;
+        int y1 = std::min(y0 + Grid2D::TILE_SIZE, grid.getHeight());
+        if (generations)
+            return BitKernel::stepRowsGenerations(grid, next, y0, y1, tx, tx + 1, birthMask, survivalMask);
+        return BitKernel::stepRows(grid, next, y0, y1, tx, tx + 1, birthMask, survivalMask);
+    }, begin, end);
+}
+
+StepCounts Simulator::stepTiled(int begin, int end)
+{
+    // Cada tile lee sus 8 vecinos de la tabla de tiles; los del borde, del anillo de halo
+    uint64_t* next = grid.getBackBitData();
+    uint16_t birthMask = currentRule.birthMask;
+    uint16_t survivalMask = currentRule.survivalMask;
+    bool generations = currentRule.states > 2;
+
+    return forEachActiveTile([&](int tx, int ty) {
+        if (generations)
+            return BitKernel::stepTileGenerations(grid, next, tx, ty, birthMask, survivalMask);
+        return BitKernel::stepTile(grid, next, tx, ty, birthMask, survivalMask);
+    }, begin, end);
+}
+
+void Simulator::stepBitsBlocked()
+{
+    const int tilesX = grid.getTilesX();
+    const int tilesY = grid.getTilesY();
+    const int blocksX = (tilesX + PASS_BLOCK_TILES - 1) / PASS_BLOCK_TILES;
+
+    // En el toro un tile del borde parcial no cubre k celdas: el vecindario 3x3 de tiles ya no
+    // contiene todas las celdas de las que depende la pasada y se recalcula todo
+    const bool partialTiles = grid.getWidth() % Grid2D::TILE_SIZE != 0 || grid.getHeight() % Grid2D::TILE_SIZE != 0;
+    if (grid.getBoundary() == BoundaryMode::TORUS && partialTiles)
+        grid.markAllTilesChanged();
+
+    // Un tile cuyo vecindario no cambió en la pasada anterior (k <= TILE_SIZE) tampoco cambia en esta
+    prepareTileFlags(stepsPerPass);
+    collectActiveTiles();
+    nextTileChanges.assign(static_cast<size_t>(tilesX) * tilesY, 0);
+    tileActive.assign(static_cast<size_t>(tilesX) * tilesY, 0);
+    for (int tile : activeTiles)
+        tileActive[tile] = 1;
+
+    // Un bloque se calcula entero si alguno de sus tiles está activo
+    activeBlocks.clear();
+    for (int by = 0; by < tilesY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            int tx0 = bx * PASS_BLOCK_TILES;
+            int tx1 = std::min(tx0 + PASS_BLOCK_TILES, tilesX);
+            if (std::any_of(tileActive.begin() + by * tilesX + tx0, tileActive.begin() + by * tilesX + tx1,
+                            [](uint8_t active) { return active != 0; }))
+                activeBlocks.push_back(by * blocksX + bx);
+        }
+    }
+    blockCounts.resize(activeBlocks.size());
+
+    // Cada banda toma un grid de paso distinto: parallelFor no lanza más bandas que hilos
+    std::atomic<int> nextScratch(0);
+    auto runBlocks = [&](int begin, int end) {
+        if (begin == end)
+            return;
+        Grid2D& scratch = blockScratch[nextScratch.fetch_add(1, std::memory_order_relaxed)];
+        scratch.setStateCount(grid.getStateCount());
+        for (int i = begin; i < end; ++i) {
+            int block = activeBlocks[i];
+            int tx0 = (block % blocksX) * PASS_BLOCK_TILES;
+            blockCounts[i] = advanceBlock(scratch, tx0, std::min(tx0 + PASS_BLOCK_TILES, tilesX), block / blocksX);
+        }
+    };
+
+    ThreadPool::run(bandPool(), static_cast<int>(activeBlocks.size()), runBlocks);
+
+    StepCounts total;
+    for (const StepCounts& block : blockCounts)
+        total += block;
+    grid.swapBuffers(total);
+    grid.swapTileChanges(nextTileChanges);
+    generation += stepsPerPass;
+}
+
+StepCounts Simulator::advanceBlock(Grid2D& scratch, int w0, int w1, int ty)
+{
+    const int k = stepsPerPass;
+    const int width = grid.getWidth();
+    const int height = grid.getHeight();
+    const int planes = grid.getPlaneCount();
+    const int wordsPerRow = grid.getWordsPerRow();
+    const uint64_t lastWordMask = grid.getLastWordMask();
+    const BoundaryMode boundary = grid.getBoundary();
+
+    // Fila r del grid de paso = fila y0 - k + r del grid; palabra j = palabra w0 - 1 + j
+    const int y0 = ty * Grid2D::TILE_SIZE;
+    const int y1 = std::min(y0 + Grid2D::TILE_SIZE, height);
+    const int rows = (y1 - y0) + 2 * k;
+    const int words = (w1 - w0) + 2;
+
+    // Carga: las celdas fuera del grid salen del modo de borde. El toro y el espejo son simétricos
+    // bajo la regla, así que evolucionar esas copias da lo mismo que releer el borde en cada paso
+    uint64_t* load = scratch.getBackBitData();
+    for (int r = 0; r < rows; ++r) {
+        int sourceY = Grid2D::wrapCoordinate(y0 - k + r, height, boundary);
+        for (int p = 0; p < planes; ++p) {
+            uint64_t* dst = load + scratch.getBitOffset(r, p);
+            if (sourceY < 0) {
+                std::fill_n(dst, words, 0);
+                continue;
+            }
+            const uint64_t* src = grid.getBitRow(sourceY, p);
+            for (int j = 0; j < words; ++j) {
+                int gw = w0 - 1 + j;
+                if (gw >= 0 && (gw < wordsPerRow - 1 || (gw == wordsPerRow - 1 && lastWordMask == ~0ULL))) {
+                    dst[j] = src[gw];
+                    continue;
+                }
+                // Palabra de halo fuera del grid (o la última, con relleno): celda a celda
+                uint64_t word = 0;
+                for (int b = 0; b < 64; ++b) {
+                    int sourceX = Grid2D::wrapCoordinate(gw * 64 + b, width, boundary);
+                    if (sourceX >= 0)
+                        word |= ((src[sourceX >> 6] >> (sourceX & 63)) & 1) << b;
+                }
+                dst[j] = word;
+            }
+        }
+    }
+    scratch.swapBuffers(StepCounts{});
+
+    // Con borde muerto las celdas de fuera deben seguir muertas en cada generación
+    const bool deadBoundary = boundary == BoundaryMode::DEAD;
+    uint64_t columnMask[PASS_BLOCK_TILES + 2];
+    for (int j = 0; j < words; ++j) {
+        int gw = w0 - 1 + j;
+        columnMask[j] = (gw < 0 || gw >= wordsPerRow) ? 0 : (gw == wordsPerRow - 1 ? lastWordMask : ~0ULL);
+    }
+
+    // Generación g: las filas [g, rows - g) siguen siendo exactas. Los bits de las palabras de halo
+    // se estropean desde fuera a una celda por generación, sin llegar al bloque (k <= 64)
+    const uint16_t birthMask = currentRule.birthMask;
+    const uint16_t survivalMask = currentRule.survivalMask;
+    for (int g = 1; g <= k; ++g) {
+        uint64_t* next = scratch.getBackBitData();
+        if (currentRule.states > 2) {
+            BitKernel::stepRowsGenerations(scratch, next, g, rows - g, 0, words, birthMask, survivalMask);
+        } else {
+            BitKernel::stepRows(scratch, next, g, rows - g, 0, words, birthMask, survivalMask);
+        }
+        if (deadBoundary) {
+            for (int r = g; r < rows - g; ++r) {
+                int y = y0 - k + r;
+                bool outside = y < 0 || y >= height;
+                for (int p = 0; p < planes; ++p) {
+                    uint64_t* row = next + scratch.getBitOffset(r, p);
+                    for (int j = 0; j < words; ++j)
+                        row[j] = outside ? 0 : row[j] & columnMask[j];
+                }
+            }
+        }
+        scratch.swapBuffers(StepCounts{});
+    }
+
+    // Escritura al buffer trasero y cambio neto de cada tile respecto al frontal
+    uint64_t* out = grid.getBackBitData();
+    StepCounts total;
+    for (int tx = w0; tx < w1; ++tx) {
+        const uint64_t mask = tx == wordsPerRow - 1 ? lastWordMask : ~0ULL;
+        const int j = tx - w0 + 1;
+        StepCounts tile;
+        for (int y = y0; y < y1; ++y) {
+            const int r = k + y - y0;
+            uint64_t wasAlive = grid.getBitRow(y)[tx] & mask;
+            uint64_t isAlive = scratch.getBitRow(r)[j] & mask;
+            uint64_t diff = 0;
+            for (int p = 0; p < planes; ++p) {
+                uint64_t before = grid.getBitRow(y, p)[tx] & mask;
+                uint64_t after = scratch.getBitRow(r, p)[j] & mask;
+                out[grid.getBitOffset(y, p) + tx] = after;
+                diff |= before ^ after;
+                if (p > 0) {
+                    wasAlive &= ~before;
+                    isAlive &= ~after;
+                }
+            }
+            tile.births += std::popcount(isAlive & ~wasAlive);
+            tile.deaths += std::popcount(wasAlive & ~isAlive);
+            tile.changed += std::popcount(diff);
+        }
+        nextTileChanges[static_cast<size_t>(ty) * grid.getTilesX() + tx] = tile.changed > 0 ? 1 : 0;
+        total += tile;
+    }
+    return total;
+}
+
+void Simulator::collectActiveTiles()
+{
+    const int tilesX = grid.getTilesX();
+    const int tilesY = grid.getTilesY();
+
+    // En el toro los tiles del borde son vecinos de los del borde opuesto
+    const BoundaryMode boundary = grid.getBoundary() == BoundaryMode::TORUS ? BoundaryMode::TORUS : BoundaryMode::DEAD;
+
+    activeTiles.clear();
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            bool active = false;
+            for (int dy = -1; dy <= 1 && !active; ++dy) {
+                int ny = Grid2D::wrapCoordinate(ty + dy, tilesY, boundary);
+                for (int dx = -1; dx <= 1 && !active; ++dx) {
+                    int nx = Grid2D::wrapCoordinate(tx + dx, tilesX, boundary);
+                    active = nx >= 0 && ny >= 0 && grid.isTileChanged(nx, ny);
+                }
+            }
+            if (active)
+                activeTiles.push_back(ty * tilesX + tx);
         }
     }
 }
 
+StepCounts Simulator::forEachActiveTile(const std::function<StepCounts(int tx, int ty)>& task, int begin, int end)
+{
+    const int tilesX = grid.getTilesX();
+    tileCounts.resize(activeTiles.size());
+
+    // Cada tile escribe su propia entrada: no hace falta sincronizar la suma
+    auto runTiles = [&](int first, int last) {
+        for (int i = begin + first; i < begin + last; ++i) {
+            int tile = activeTiles[i];
+            tileCounts[i] = task(tile % tilesX, tile / tilesX);
+            nextTileChanges[tile] = tileCounts[i].changed > 0 ? 1 : 0;
+        }
+    };
+
+    ThreadPool::run(bandPool(), end - begin, runTiles);
+
+    StepCounts total;
+    for (int i = begin; i < end; ++i)
+        total += tileCounts[i];
+    return total;
+}
+
+ThreadPool* Simulator::bandPool() const
+{
+    if (static_cast<int64_t>(grid.getWidth()) * grid.getHeight() < ThreadPool::PARALLEL_MIN_CELLS)
+        return nullptr;
+    return pool.get();
+}
+
+void Simulator::setThreadCount(int threadCount, bool pinThreads)
+{
+    pool = std::make_unique<ThreadPool>(threadCount, pinThreads);
+    resizeBlockScratch();
+}
+
+void Simulator::setStepsPerPass(int steps)
+{
+    steps = std::clamp(steps, 1, MAX_STEPS_PER_PASS);
+    if (steps == stepsPerPass)
+        return;
+    stepsPerPass = steps;
+    resizeBlockScratch();
+    // Los flags de tiles de una pasada de k generaciones no valen para otro k
+    grid.markAllTilesChanged();
+}
+
+void Simulator::resizeBlockScratch()
+{
+    blockScratch.clear();
+    if (stepsPerPass <= 1)
+        return;
+    // Con halos vacíos los kernels leen el grid de paso sin comprobar límites; la zona que una banda
+    // no carga solo toca palabras de halo del bloque, que ya se estropean desde fuera
+    blockScratch.reserve(pool->getThreadCount());
+    for (int i = 0; i < pool->getThreadCount(); ++i)
+        blockScratch.emplace_back((PASS_BLOCK_TILES + 2) * Grid2D::TILE_SIZE, Grid2D::TILE_SIZE + 2 * stepsPerPass,
+                                  GridLayout::BITS);
+}
+
+void Simulator::setSlicedStepping(bool enabled)
+{
+    if (enabled == slicedStepping)
+        return;
+    slicedStepping = enabled;
+    // stepFor() confirma una generación cada vez: los flags de una pasada bloqueada de step() no le valen
+    grid.markAllTilesChanged();
+}
+
+void Simulator::setRuleType(RuleType type)
+{
+    setRule(Rules::fromType(type));
+}
+
+void Simulator::setRule(const Rule& rule)
+{
+    currentRule = rule;
+    grid.setStateCount(rule.states);
+    // Con otra regla las regiones estables dejan de serlo
+    grid.markAllTilesChanged();
+    cycleDetector.reset();
+}
+
 void Simulator::nextRule()
 {
-    int nextRuleIndex = (static_cast<int>(currentRule) + 1) % static_cast<int>(RuleType::COUNT);
-    currentRule = static_cast<RuleType>(nextRuleIndex);
+    // Desde una regla personalizada (COUNT) se vuelve a la primera
+    int nextRuleIndex = (static_cast<int>(getRuleType()) + 1) % static_cast<int>(RuleType::COUNT);
+    setRuleType(static_cast<RuleType>(nextRuleIndex));
+}
+
+const char* Simulator::getEngineName(EngineType type)
+{
+    switch (type) {
+    case EngineType::GRID:
+        return "Grid";
+    case EngineType::HASHLIFE:
+        return "HashLife";
+    case EngineType::SPARSE:
+        return "Sparse";
+    case EngineType::LENIA:
+        return "Lenia";
+    default:
+        return "Unknown";
+    }
+}
+
+void Simulator::setStepBudget(const StepBudget& budget)
+{
+    stepBudget = clampStepBudget(budget);
 }
 
 void Simulator::update(float deltaTime)
 {
+    updateReport.executed = 0;
+    updateReport.deferred = 0;
     if (paused)
         return;
 
     accumulator += deltaTime;
 
     // Ejecutar steps según el tiempo acumulado
-    while (accumulator >= updateInterval) {
-        step();
-        generation++;
-        accumulator -= updateInterval;
+    int pendingSteps = takeDueSteps(accumulator, updateInterval, stepBudget, updateReport);
+
+    // En un ciclo ya detectado basta con avanzar el contador y simular el resto del periodo
+    if (pendingSteps > 0 && autoFastForward && fastForward(generation + int64_t(pendingSteps) * stepsPerPass)) {
+        updateReport.executed = pendingSteps;
+        return;
+    }
+
+    // Siempre se da al menos un paso (o un trozo de uno reanudable); lo que no cabe en el tiempo vuelve al acumulador
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    int executed = 0;
+    while (executed < pendingSteps) {
+        if (slicedStepping) {
+            // Una generación más larga que el presupuesto se deja a medias y sigue en la siguiente llamada
+            float elapsed = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+            float remaining = stepBudget.maxMilliseconds > 0.0f ? std::max(stepBudget.maxMilliseconds - elapsed, 0.01f)
+                                                                : 0.0f;
+            if (!stepFor(remaining))
+                break;
+        } else {
+            step();
+        }
+        executed++;
+        float elapsed = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        if (stepBudget.maxMilliseconds > 0.0f && elapsed >= stepBudget.maxMilliseconds)
+            break;
     }
+    deferSteps(accumulator, updateInterval, pendingSteps, executed, updateReport);
 }
 
 }  // namespace Core
@@ -8,17 +8,41 @@
 #ifndef SIMULATOR_HPP
 #define SIMULATOR_HPP
 
+#include "CycleDetector.hpp"
 #include "Grid2D.hpp"
+#include "HashLife.hpp"
+#include "LargerThanLife.hpp"
+#include "Lenia.hpp"
 #include "Rules.hpp"
+#include "SparseUniverse.hpp"
+#include "StepBudget.hpp"
+#include "ThreadPool.hpp"
+#include <functional>
+#include <memory>
 
 namespace Core {
 
+/**
+ * @enum EngineType
+ * @brief Motores de simulación disponibles
+ */
+enum class EngineType {
+    GRID,      // Kernels sobre el grid acotado (bits/bytes, tiles activos)
+    HASHLIFE,  // Quadtree memoizado sobre el plano infinito, avanza 2^k generaciones
+    SPARSE,    // Bloques de 64x64 en una tabla hash, plano ilimitado
+    LENIA,     // Campo continuo con kernel de anillos (convolución por FFT)
+    COUNT
+};
+
 /**
  * @class Simulator
  * @brief Aplica reglas de evolución al grid
  */
 class Simulator {
 public:
+    // Máximo de generaciones por pasada: el halo de un bloque es una palabra (y un tile) de ancho
+    static constexpr int MAX_STEPS_PER_PASS = Grid2D::TILE_SIZE;
+
     /**
      * @brief Constructor
      * @param grid Referencia al grid a simular
@@ -27,9 +51,79 @@ public:
 
     /**
      * @brief Ejecuta un paso de simulación (Game of Life)
+     *
+     * Con el motor HASHLIFE un paso avanza 2^k generaciones; con el motor
+     * GRID avanza getStepsPerPass() generaciones.
      */
     void step();
 
+    /**
+     * @brief Avanza el paso pendiente durante un tiempo limitado (paso reanudable)
+     *
+     * Calcula tiles activos en el buffer trasero hasta agotar el tiempo y
+     * guarda por dónde va; el grid no cambia hasta que la generación está
+     * completa y se confirma de una vez. Si el grid, la regla o la generación
+     * cambian entre llamadas, lo calculado se descarta y la generación vuelve
+     * a empezar. Cada llamada calcula al menos un trozo, así que el paso
+     * siempre progresa. La pasada va generación a generación (sin bloqueo
+     * temporal), y los motores sin tiles (HashLife, Sparse, Lenia, Larger
+     * than Life) dan el paso entero.
+     *
+     * @param milliseconds Tiempo disponible (<= 0 = sin límite)
+     * @return true si el paso (getStepsPerPass() generaciones) se completó
+     */
+    bool stepFor(float milliseconds);
+
+    /**
+     * @brief Verifica si hay un paso a medias de stepFor()
+     * @return true si la siguiente llamada a stepFor() continúa un paso
+     */
+    bool isStepPending() const { return slice.pending; }
+
+    /**
+     * @brief Obtiene cuánto lleva calculado el paso a medias
+     * @return Fracción de 0 a 1 (0 sin paso pendiente)
+     */
+    float getStepProgress() const;
+
+    /**
+     * @brief Activa los pasos reanudables en update()
+     *
+     * Con ellos update() no se pasa de getStepBudget().maxMilliseconds aunque
+     * una generación tarde más: la deja a medias y la continúa en la
+     * siguiente llamada. Desactivados por defecto: stepFor() avanza de una
+     * en una y no aprovecha el bloqueo temporal de setStepsPerPass().
+     *
+     * @param enabled true para usar stepFor() en lugar de step()
+     */
+    void setSlicedStepping(bool enabled);
+
+    /**
+     * @brief Verifica si update() usa pasos reanudables
+     * @return true si están activos
+     */
+    bool isSlicedStepping() const { return slicedStepping; }
+
+    /**
+     * @brief Establece cuántas generaciones avanza cada paso del motor GRID
+     *
+     * En el layout BITS, con más de una generación por pasada cada bloque de
+     * tiles se carga con un halo de k celdas y avanza k generaciones mientras
+     * sigue en L1/L2 antes de volver a memoria (bloqueo temporal). El resultado
+     * es idéntico a k pasos sueltos; los contadores de getLastStep() pasan a
+     * ser el cambio neto de la pasada. El layout BYTES y las reglas Larger
+     * than Life repiten k pasos sueltos.
+     *
+     * @param steps Generaciones por pasada (1 a MAX_STEPS_PER_PASS)
+     */
+    void setStepsPerPass(int steps);
+
+    /**
+     * @brief Obtiene las generaciones que avanza cada paso del motor GRID
+     * @return Generaciones por pasada
+     */
+    int getStepsPerPass() const { return stepsPerPass; }
+
     /**
      * @brief Establece si la simulación está pausada
      * @param paused true para pausar
@@ -53,36 +147,221 @@ public:
      */
     void setSpeed(float stepsPerSecond) { updateInterval = 1.0f / stepsPerSecond; }
 
+    /**
+     * @brief Limita el trabajo de cada llamada a update()
+     *
+     * Si la velocidad pedida supera lo que da la máquina (o tras un parón),
+     * los pasos que no caben en maxMilliseconds se aplazan y el tiempo debido
+     * se recorta a maxSteps intervalos: lo que sobra se descarta en lugar de
+     * alargar cada llamada más que la anterior.
+     *
+     * @param budget Pasos y milisegundos por llamada (maxSteps >= 1)
+     */
+    void setStepBudget(const StepBudget& budget);
+
+    /**
+     * @brief Obtiene el límite de trabajo por llamada a update()
+     * @return Presupuesto actual
+     */
+    const StepBudget& getStepBudget() const { return stepBudget; }
+
+    /**
+     * @brief Obtiene los pasos ejecutados, aplazados y descartados por update()
+     * @return Informe de la última llamada (dropped es acumulado)
+     */
+    const UpdateReport& getUpdateReport() const { return updateReport; }
+
     /**
      * @brief Establece el tipo de reglas
      * @param type Tipo de reglas a usar
      */
-    void setRuleType(RuleType type) { currentRule = type; }
+    void setRuleType(RuleType type);
 
     /**
      * @brief Obtiene el tipo de reglas actual
-     * @return Tipo de reglas
+     * @return Tipo de reglas (RuleType::COUNT si la regla es personalizada)
+     */
+    RuleType getRuleType() const { return Rules::findType(currentRule); }
+
+    /**
+     * @brief Establece una regla B/S arbitraria
+     * @param rule Regla compilada (ver Rules::parse)
      */
-    RuleType getRuleType() const { return currentRule; }
+    void setRule(const Rule& rule);
+
+    /**
+     * @brief Obtiene la regla actual
+     * @return Regla
+     */
+    const Rule& getRule() const { return currentRule; }
 
     /**
      * @brief Cambia a la siguiente regla
      */
     void nextRule();
 
+    /**
+     * @brief Establece el modo de borde del grid
+     *
+     * Solo afecta al motor GRID; HashLife y el universo disperso no tienen bordes.
+     *
+     * @param mode Celdas muertas, toro o espejo
+     */
+    void setBoundary(BoundaryMode mode)
+    {
+        grid.setBoundary(mode);
+        cycleDetector.reset();
+    }
+
+    /**
+     * @brief Obtiene el modo de borde del grid
+     * @return Modo actual
+     */
+    BoundaryMode getBoundary() const { return grid.getBoundary(); }
+
     /**
      * @brief Obtiene el número de generación actual
      * @return Generación
      */
-    int getGeneration() const { return generation; }
+    int64_t getGeneration() const { return generation; }
 
     /**
      * @brief Reinicia el contador de generaciones
      */
-    void resetGeneration() { generation = 0; }
+    void resetGeneration()
+    {
+        generation = 0;
+        cycleDetector.reset();
+    }
+
+    /**
+     * @brief Obtiene el ciclo en el que ha entrado el grid
+     *
+     * Solo se detecta con el grid acotado (motor GRID o reglas que lo usan):
+     * en HashLife y Sparse la ventana no es todo el universo. Con varias
+     * generaciones por paso el periodo es múltiplo de las generaciones por paso.
+     *
+     * @return Ciclo (period == 0 si no se ha detectado)
+     */
+    const CycleInfo& getCycle() const { return cycleDetector.getCycle(); }
+
+    /**
+     * @brief Obtiene el hash incremental del grid tras el último paso
+     * @return Hash de 64 bits
+     */
+    uint64_t getStateHash() const { return cycleDetector.getHash(); }
+
+    /**
+     * @brief Salta a una generación posterior usando el ciclo detectado
+     *
+     * El estado de la generación objetivo es el de generation + (objetivo -
+     * generation) mod periodo, así que solo se simulan menos de un periodo de
+     * generaciones.
+     *
+     * @param targetGeneration Generación de destino (>= la actual)
+     * @return false si no hay ciclo vigente (el grid no cambió) y no se hizo nada
+     */
+    bool fastForward(int64_t targetGeneration);
+
+    /**
+     * @brief Activa el salto automático de update() al detectar un ciclo
+     * @param enabled true para saltar en lugar de simular los pasos pendientes
+     */
+    void setAutoFastForward(bool enabled) { autoFastForward = enabled; }
+
+    /**
+     * @brief Verifica si update() salta los ciclos detectados
+     * @return true si está activo
+     */
+    bool isAutoFastForward() const { return autoFastForward; }
+
+    /**
+     * @brief Configura los hilos usados por step()
+     * @param threadCount Hilos totales (0 = núcleos disponibles, 1 = serie)
+     * @param pinThreads true para fijar cada hilo a un núcleo
+     */
+    void setThreadCount(int threadCount, bool pinThreads = false);
+
+    /**
+     * @brief Obtiene el número de hilos usados por step()
+     * @return Número de hilos
+     */
+    int getThreadCount() const { return pool->getThreadCount(); }
+
+    /**
+     * @brief Obtiene los hilos del simulador para repartir otro trabajo sobre el mismo grid
+     * @return Pool (válido hasta el siguiente setThreadCount())
+     */
+    ThreadPool* getThreadPool() const { return pool.get(); }
+
+    /**
+     * @brief Selecciona el motor de simulación
+     *
+     * HASHLIFE y SPARSE solo admiten reglas de dos estados, radio 1 y sin B0; con otras se usa GRID.
+     * LENIA ignora la regla discreta y usa getLenia().getRule().
+     *
+     * @param type Motor a usar
+     */
+    void setEngine(EngineType type);
+
+    /**
+     * @brief Obtiene el motor de simulación seleccionado
+     * @return Motor actual
+     */
+    EngineType getEngine() const { return engine; }
 
     /**
-     * @brief Actualiza el simulador (llama step() según tiempo)
+     * @brief Obtiene el nombre de un motor
+     * @param type Motor
+     * @return Nombre legible
+     */
+    static const char* getEngineName(EngineType type);
+
+    /**
+     * @brief Establece cuántas generaciones avanza cada paso de HashLife (2^k)
+     * @param k Exponente
+     */
+    void setHashLifeStepLog2(int k) { hashLife.setStepLog2(k); }
+
+    /**
+     * @brief Obtiene el motor HashLife (límite de memoria, nodos, ...)
+     * @return Referencia al motor
+     */
+    HashLife& getHashLife() { return hashLife; }
+
+    /**
+     * @brief Obtiene el universo disperso (bloques, memoria, ...)
+     * @return Referencia al universo
+     */
+    SparseUniverse& getSparseUniverse() { return sparse; }
+
+    /**
+     * @brief Obtiene el motor Lenia (campo, regla, ...)
+     * @return Referencia al motor
+     */
+    const Lenia& getLenia() const { return lenia; }
+
+    /**
+     * @brief Establece el kernel y la función de crecimiento del motor LENIA
+     * @param rule Regla continua
+     */
+    void setLeniaRule(const LeniaRule& rule) { lenia.setRule(rule); }
+
+    /**
+     * @brief Llena el campo de Lenia con una sopa aleatoria y la publica en el grid
+     * @param density Fracción de celdas no nulas en la zona central
+     * @param seed Semilla
+     */
+    void randomizeLenia(float density, uint64_t seed);
+
+    /**
+     * @brief Obtiene el número de tiles recalculados en el último paso
+     * @return Tiles activos
+     */
+    int getActiveTileCount() const { return static_cast<int>(activeTiles.size()); }
+
+    /**
+     * @brief Actualiza el simulador (llama step() según tiempo, dentro de getStepBudget())
      * @param deltaTime Tiempo desde el último frame
      */
     void update(float deltaTime);
@@ -92,8 +371,199 @@ private:
     bool paused;
     float updateInterval;  // Segundos entre updates
     float accumulator;     // Acumulador de tiempo
-    RuleType currentRule;  // Regla actual
-    int generation;        // Contador de generaciones
+    StepBudget stepBudget;
+    UpdateReport updateReport;
+    Rule currentRule;      // Regla actual
+    int64_t generation;    // Contador de generaciones
+    int stepsPerPass;      // Generaciones por paso del motor GRID
+
+    // Hilos persistentes: cada paso se reparte por tiles activos
+    std::unique_ptr<ThreadPool> pool;
+
+    // Tiles (índice ty * tilesX + tx) cuyo vecindario cambió en la generación anterior
+    std::vector<int> activeTiles;
+    std::vector<uint8_t> nextTileChanges;
+    int tileFlagGenerations;  // Generaciones que cubren los flags de cambio del grid (1 o la pasada bloqueada)
+    std::vector<StepCounts> tileCounts;  // Contadores de cada tile activo (se suman al final del paso)
+
+    // Bloqueo temporal: filas de tiles partidas en bloques de PASS_BLOCK_TILES tiles
+    std::vector<uint8_t> tileActive;       // Flag por tile de activeTiles
+    std::vector<int> activeBlocks;         // Índice by * bloques por fila + bx
+    std::vector<StepCounts> blockCounts;  // Contadores de cada bloque activo
+    std::vector<Grid2D> blockScratch;      // Grid de paso de cada hilo, reutilizado entre pasadas
+
+    // Motores de plano infinito; el grid es una ventana sobre ellos
+    EngineType engine;
+    HashLife hashLife;
+    SparseUniverse sparse;
+    uint64_t engineRevision;  // Revisión del grid tras la última sincronización con el motor
+
+    // Reglas de radio > 1 (o von Neumann): tablas de sumas sobre el grid completo
+    LargerThanLife largerThanLife;
+
+    // Autómata continuo; el grid recibe sus celdas >= 0.5 como vivas
+    Lenia lenia;
+
+    // Hash por tiles y estados recientes del grid acotado
+    CycleDetector cycleDetector;
+    uint64_t cycleRevision;  // Revisión del grid tras el último registro
+    bool autoFastForward;
+
+    // Paso a medias de stepFor(): vale mientras el grid, la regla y la generación sean los del inicio
+    struct SlicedStep {
+        bool pending = false;
+        bool hashing = false;         // Generaciones hechas; falta el registro de ciclos
+        int cursor = 0;               // Siguiente índice de activeTiles (o fila de tiles del registro)
+        int generationsLeft = 0;      // Generaciones de la pasada que faltan, incluida la actual
+        StepCounts counts;            // Suma de los tiles ya calculados
+        uint64_t revision = 0;        // Revisión del grid al empezar la generación
+        int64_t generation = 0;
+        Rule rule;
+        float millisecondsPerTile = 0.0f;  // Coste medido del último trozo
+        float millisecondsPerRow = 0.0f;   // Ídem del registro de ciclos, por fila de tiles
+    };
+    SlicedStep slice;
+    bool slicedStepping;
+
+    /**
+     * @brief Obtiene los hilos con los que repartir un paso sobre el grid
+     * @return Pool, o nullptr si el grid es demasiado pequeño para repartirlo
+     */
+    ThreadPool* bandPool() const;
+
+    /**
+     * @brief Calcula activeTiles a partir de los flags de cambio del grid
+     */
+    void collectActiveTiles();
+
+    /**
+     * @brief Ejecuta task sobre un rango de tiles activos (en serie si el grid es pequeño)
+     * @param task Función que calcula el tile y devuelve sus contadores
+     * @param begin Primer índice de activeTiles
+     * @param end Índice final (exclusivo)
+     * @return Suma de los contadores de los tiles del rango
+     */
+    StepCounts forEachActiveTile(const std::function<StepCounts(int tx, int ty)>& task, int begin, int end);
+
+    /**
+     * @brief Prepara una generación del motor GRID: halo, tiles activos y flags de cambio
+     */
+    void beginGeneration();
+
+    /**
+     * @brief Calcula un rango de tiles activos en el buffer trasero según el layout
+     * @param begin Primer índice de activeTiles
+     * @param end Índice final (exclusivo)
+     * @return Contadores de los tiles del rango
+     */
+    StepCounts stepActiveTiles(int begin, int end);
+
+    /**
+     * @brief Publica la generación calculada (intercambia buffers y flags de cambio)
+     * @param counts Contadores de todos los tiles activos
+     */
+    void commitGeneration(const StepCounts& counts);
+
+    /**
+     * @brief Empieza una generación de stepFor() y guarda con qué estado empezó
+     */
+    void beginSlicedGeneration();
+
+    /**
+     * @brief Registra el estado actual en el detector de ciclos
+     */
+    void recordCycle();
+
+    /**
+     * @brief Paso con HashLife (recarga el grid si fue editado)
+     */
+    void stepHashLife();
+
+    /**
+     * @brief Paso con el universo disperso (recarga el grid si fue editado)
+     */
+    void stepSparse();
+
+    /**
+     * @brief Verifica si el siguiente paso se calcula sobre el grid acotado
+     * @return false con Lenia o con HashLife/Sparse y una regla que admitan
+     */
+    bool stepsOnGrid() const;
+
+    /**
+     * @brief Avanza una sola generación sobre el grid acotado
+     */
+    void stepSingleGeneration();
+
+    /**
+     * @brief Prepara los flags de cambio de tiles para un paso de varias generaciones
+     *
+     * Los flags de una pasada bloqueada registran el cambio neto de sus k
+     * generaciones: un oscilador cuyo periodo divide a k aparece estable.
+     * Solo valen para otro paso del mismo tamaño; si no, se marcan todos.
+     *
+     * @param generations Generaciones del paso que va a leer los flags
+     */
+    void prepareTileFlags(int generations);
+
+    /**
+     * @brief Paso de Lenia (recarga el campo si el grid fue editado)
+     */
+    void stepLenia();
+
+    /**
+     * @brief Paso con una regla Larger than Life (sin tiles activos)
+     */
+    void stepLargerThanLife();
+
+    /**
+     * @brief Una generación del motor GRID sobre el grid acotado
+     */
+    void stepGrid();
+
+    /**
+     * @brief stepsPerPass generaciones sobre el layout empaquetado con bloqueo temporal
+     */
+    void stepBitsBlocked();
+
+    /**
+     * @brief Crea un grid de paso por hilo para la altura de stepsPerPass (ninguno si no hay bloqueo)
+     */
+    void resizeBlockScratch();
+
+    /**
+     * @brief Avanza un bloque stepsPerPass generaciones y lo escribe en el buffer trasero
+     * @param scratch Grid de paso (alto TILE_SIZE + 2 * stepsPerPass, ancho PASS_BLOCK_TILES + 2 palabras)
+     * @param w0 Primera palabra (tile) del bloque
+     * @param w1 Palabra final (exclusiva)
+     * @param ty Fila de tiles
+     * @return Cambio neto del bloque durante la pasada
+     */
+    StepCounts advanceBlock(Grid2D& scratch, int w0, int w1, int ty);
+
+    /**
+     * @brief Tiles activos sobre el layout de bytes (SimdKernel)
+     * @param begin Primer índice de activeTiles
+     * @param end Índice final (exclusivo)
+     * @return Contadores de los tiles del rango
+     */
+    StepCounts stepBytes(int begin, int end);
+
+    /**
+     * @brief Tiles activos sobre el layout empaquetado (BitKernel)
+     * @param begin Primer índice de activeTiles
+     * @param end Índice final (exclusivo)
+     * @return Contadores de los tiles del rango
+     */
+    StepCounts stepBits(int begin, int end);
+
+    /**
+     * @brief Tiles activos sobre el layout por tiles en orden de Morton (BitKernel::stepTile)
+     * @param begin Primer índice de activeTiles
+     * @param end Índice final (exclusivo)
+     * @return Contadores de los tiles del rango
+     */
+    StepCounts stepTiled(int begin, int end);
 };
 
 }  // namespace Core
@@ -0,0 +1,87 @@
+/**
+ * @file Simulator3D.cpp
+ * @brief Implementación del simulador 3D
+ */
+
+#include "Simulator3D.hpp"
+#include "BitKernel3D.hpp"
+#include <chrono>
+
+namespace Core {
+
+Simulator3D::Simulator3D(Grid3D& grid) :
+    grid(grid), paused(true), updateInterval(0.1f), accumulator(0.0f),
+    currentRule(Rules3D::make(1u << 4, 1u << 4, 5, Neighborhood::MOORE)), generation(0),
+    pool(std::make_unique<ThreadPool>())
+{
+    grid.setStateCount(currentRule.states);
+}
+
+void Simulator3D::step()
+{
+    grid.refreshHalo();
+
+    // Cada banda de capas escribe solo sus filas del buffer trasero y sus contadores
+    uint64_t* next = grid.getBackBitData();
+    sliceCounts.resize(grid.getDepth());
+    auto runSlices = [&](int begin, int end) {
+        for (int z = begin; z < end; ++z)
+            sliceCounts[z] = BitKernel3D::stepSlices(grid, next, z, z + 1, currentRule);
+    };
+    ThreadPool::run(bandPool(), grid.getDepth(), runSlices);
+
+    StepCounts total;
+    for (const StepCounts& slice : sliceCounts)
+        total += slice;
+    grid.swapBuffers(total);
+    generation++;
+}
+
+ThreadPool* Simulator3D::bandPool() const
+{
+    if (grid.getCellCount() < ThreadPool::PARALLEL_MIN_CELLS)
+        return nullptr;
+    return pool.get();
+}
+
+void Simulator3D::setRule(const Rule3D& rule)
+{
+    currentRule = rule;
+    grid.setStateCount(rule.states);
+}
+
+void Simulator3D::setThreadCount(int threadCount, bool pinThreads)
+{
+    pool = std::make_unique<ThreadPool>(threadCount, pinThreads);
+}
+
+void Simulator3D::setStepBudget(const StepBudget& budget)
+{
+    stepBudget = clampStepBudget(budget);
+}
+
+void Simulator3D::update(float deltaTime)
+{
+    updateReport.executed = 0;
+    updateReport.deferred = 0;
+    if (paused)
+        return;
+
+    accumulator += deltaTime;
+
+    // Ejecutar steps según el tiempo acumulado; lo que no cabe en el tiempo vuelve al acumulador
+    int pendingSteps = takeDueSteps(accumulator, updateInterval, stepBudget, updateReport);
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    int executed = 0;
+    while (executed < pendingSteps) {
+        step();
+        executed++;
+        float elapsed = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        if (stepBudget.maxMilliseconds > 0.0f && elapsed >= stepBudget.maxMilliseconds)
+            break;
+    }
+    deferSteps(accumulator, updateInterval, pendingSteps, executed, updateReport);
+}
+
+}  // namespace Core
@@ -0,0 +1,160 @@
+/**
+ * @file Simulator3D.hpp
+ * @brief Motor de simulación para autómatas celulares 3D
+ *
+ * Aplica una Rule3D al Grid3D repartiendo las capas Z entre los hilos.
+ */
+
+#ifndef SIMULATOR3D_HPP
+#define SIMULATOR3D_HPP
+
+#include "Grid3D.hpp"
+#include "Rules3D.hpp"
+#include "StepBudget.hpp"
+#include "ThreadPool.hpp"
+#include <memory>
+
+namespace Core {
+
+/**
+ * @class Simulator3D
+ * @brief Aplica reglas de evolución 3D al grid
+ */
+class Simulator3D {
+public:
+    /**
+     * @brief Constructor (regla 4/4/5/M)
+     * @param grid Referencia al grid a simular
+     */
+    Simulator3D(Grid3D& grid);
+
+    /**
+     * @brief Ejecuta un paso de simulación
+     */
+    void step();
+
+    /**
+     * @brief Establece si la simulación está pausada
+     * @param paused true para pausar
+     */
+    void setPaused(bool paused) { this->paused = paused; }
+
+    /**
+     * @brief Verifica si está pausada
+     * @return true si está pausada
+     */
+    bool isPaused() const { return paused; }
+
+    /**
+     * @brief Alterna pausa/ejecución
+     */
+    void togglePause() { paused = !paused; }
+
+    /**
+     * @brief Establece la velocidad de simulación
+     * @param stepsPerSecond Pasos por segundo
+     */
+    void setSpeed(float stepsPerSecond) { updateInterval = 1.0f / stepsPerSecond; }
+
+    /**
+     * @brief Establece la regla (ajusta los estados del grid)
+     * @param rule Regla (ver Rules3D::parse)
+     */
+    void setRule(const Rule3D& rule);
+
+    /**
+     * @brief Obtiene la regla actual
+     * @return Regla
+     */
+    const Rule3D& getRule() const { return currentRule; }
+
+    /**
+     * @brief Establece el modo de borde del grid
+     * @param mode Celdas muertas, toro o espejo
+     */
+    void setBoundary(BoundaryMode mode) { grid.setBoundary(mode); }
+
+    /**
+     * @brief Obtiene el modo de borde del grid
+     * @return Modo actual
+     */
+    BoundaryMode getBoundary() const { return grid.getBoundary(); }
+
+    /**
+     * @brief Obtiene el número de generación actual
+     * @return Generación
+     */
+    int64_t getGeneration() const { return generation; }
+
+    /**
+     * @brief Reinicia el contador de generaciones
+     */
+    void resetGeneration() { generation = 0; }
+
+    /**
+     * @brief Configura los hilos usados por step()
+     * @param threadCount Hilos totales (0 = núcleos disponibles, 1 = serie)
+     * @param pinThreads true para fijar cada hilo a un núcleo
+     */
+    void setThreadCount(int threadCount, bool pinThreads = false);
+
+    /**
+     * @brief Obtiene el número de hilos usados por step()
+     * @return Número de hilos
+     */
+    int getThreadCount() const { return pool->getThreadCount(); }
+
+    /**
+     * @brief Obtiene los hilos del simulador para repartir otro trabajo sobre el mismo volumen
+     * @return Pool (válido hasta el siguiente setThreadCount())
+     */
+    ThreadPool* getThreadPool() const { return pool.get(); }
+
+    /**
+     * @brief Limita el trabajo de cada llamada a update()
+     * @param budget Pasos y milisegundos máximos (maxSteps >= 1)
+     */
+    void setStepBudget(const StepBudget& budget);
+
+    /**
+     * @brief Obtiene el límite de trabajo por llamada a update()
+     * @return Presupuesto actual
+     */
+    const StepBudget& getStepBudget() const { return stepBudget; }
+
+    /**
+     * @brief Obtiene los pasos ejecutados, aplazados y descartados por update()
+     * @return Informe de la última llamada
+     */
+    const UpdateReport& getUpdateReport() const { return updateReport; }
+
+    /**
+     * @brief Actualiza el simulador (llama step() según tiempo, dentro de getStepBudget())
+     * @param deltaTime Tiempo desde el último frame
+     */
+    void update(float deltaTime);
+
+private:
+    Grid3D& grid;
+    bool paused;
+    float updateInterval;  // Segundos entre updates
+    float accumulator;     // Acumulador de tiempo
+    StepBudget stepBudget;
+    UpdateReport updateReport;
+    Rule3D currentRule;    // Regla actual
+    int64_t generation;    // Contador de generaciones
+
+    // Hilos persistentes: cada paso se reparte por bandas de capas Z
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<StepCounts> sliceCounts;  // Contadores de cada capa (se suman al final del paso)
+
+    /**
+     * @brief Obtiene los hilos con los que repartir un paso sobre el grid
+     * @return Pool, o nullptr si el grid es demasiado pequeño para repartirlo
+     */
+    ThreadPool* bandPool() const;
+};
+
+}  // namespace Core
+
+#endif  // SIMULATOR3D_HPP
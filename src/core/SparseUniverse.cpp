@@ -0,0 +1,180 @@
+/**
+ * @file SparseUniverse.cpp
+ * @brief Implementación del universo disperso por bloques
+ */
+
+#include "SparseUniverse.hpp"
+#include "BitKernel.hpp"
+#include <bit>
+
+namespace Core {
+
+// Bloque vacío compartido para los vecinos que no existen
+static const uint64_t EMPTY_ROWS[SparseUniverse::CHUNK_SIZE] = {};
+
+// Desplazamientos de los vecinos en el orden de BitKernel::stepBlock (N, S, W, E, NW, NE, SW, SE)
+static const int NEIGHBOR_OFFSETS[8][2] = { { 0, -1 }, { 0, 1 },  { -1, 0 }, { 1, 0 },
+                                            { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+
+SparseUniverse::SparseUniverse() : birthMask(1u << 3), survivalMask((1u << 2) | (1u << 3)) { }
+
+void SparseUniverse::setRule(uint16_t birthMask, uint16_t survivalMask)
+{
+    this->birthMask = birthMask;
+    this->survivalMask = survivalMask;
+}
+
+void SparseUniverse::clear()
+{
+    chunks.clear();
+}
+
+CellState SparseUniverse::getCell(int64_t x, int64_t y) const
+{
+    int64_t cx = chunkCoord(x);
+    int64_t cy = chunkCoord(y);
+    const Chunk* chunk = find(cx, cy);
+    if (!chunk)
+        return CellState::DEAD;
+    uint64_t row = chunk->rows[y - cy * CHUNK_SIZE];
+    return static_cast<CellState>((row >> (x - cx * CHUNK_SIZE)) & 1);
+}
+
+void SparseUniverse::setCell(int64_t x, int64_t y, CellState state)
+{
+    int64_t cx = chunkCoord(x);
+    int64_t cy = chunkCoord(y);
+    if (state != CellState::ALIVE && !find(cx, cy))
+        return;
+
+    Chunk& chunk = chunks[keyOf(cx, cy)];
+    uint64_t& row = chunk.rows[y - cy * CHUNK_SIZE];
+    uint64_t mask = 1ULL << (x - cx * CHUNK_SIZE);
+    row = (state == CellState::ALIVE) ? (row | mask) : (row & ~mask);
+    chunk.alive = true;  // Se revisa en el siguiente paso
+}
+
+void SparseUniverse::step(ThreadPool* pool)
+{
+    // 1. Reservar los bloques vecinos a los que llega actividad desde un borde
+    toCreate.clear();
+    for (const auto& [key, chunk] : chunks) {
+        int64_t cx = static_cast<int32_t>(key >> 32);
+        int64_t cy = static_cast<int32_t>(key & 0xFFFFFFFFu);
+
+        uint64_t westColumn = 0, eastColumn = 0;
+        for (uint64_t row : chunk.rows) {
+            westColumn |= row & 1;
+            eastColumn |= row >> 63;
+        }
+        uint64_t top = chunk.rows[0];
+        uint64_t bottom = chunk.rows[CHUNK_SIZE - 1];
+
+        auto request = [&](bool needed, int dx, int dy) {
+            if (needed && !find(cx + dx, cy + dy))
+                toCreate.push_back(keyOf(cx + dx, cy + dy));
+        };
+        request(top != 0, 0, -1);
+        request(bottom != 0, 0, 1);
+        request(westColumn != 0, -1, 0);
+        request(eastColumn != 0, 1, 0);
+        request((top & 1) != 0, -1, -1);
+        request((top >> 63) != 0, 1, -1);
+        request((bottom & 1) != 0, -1, 1);
+        request((bottom >> 63) != 0, 1, 1);
+    }
+    for (uint64_t key : toCreate) {
+        chunks.try_emplace(key);
+    }
+
+    // 2. Lista de trabajo con los punteros a los 8 vecinos (estables mientras no se inserte)
+    work.clear();
+    work.reserve(chunks.size());
+    for (auto& [key, chunk] : chunks) {
+        int64_t cx = static_cast<int32_t>(key >> 32);
+        int64_t cy = static_cast<int32_t>(key & 0xFFFFFFFFu);
+        Work item{ &chunk, {} };
+        for (int i = 0; i < 8; ++i) {
+            const Chunk* neighbor = find(cx + NEIGHBOR_OFFSETS[i][0], cy + NEIGHBOR_OFFSETS[i][1]);
+            item.neighbors[i] = neighbor ? neighbor->rows.data() : EMPTY_ROWS;
+        }
+        work.push_back(item);
+    }
+
+    // 3. Calcular la siguiente generación de cada bloque
+    auto stepRange = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            Chunk& chunk = *work[i].chunk;
+            chunk.alive = BitKernel::stepBlock(chunk.rows.data(), work[i].neighbors, chunk.next.data(), birthMask,
+                                               survivalMask)
+                          != 0;
+        }
+    };
+    ThreadPool::run(pool, static_cast<int>(work.size()), stepRange);
+
+    // 4. Confirmar y liberar los bloques que quedaron vacíos
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        if (!it->second.alive) {
+            it = chunks.erase(it);
+        } else {
+            it->second.rows = it->second.next;
+            ++it;
+        }
+    }
+}
+
+void SparseUniverse::loadFromGrid(const Grid2D& grid)
+{
+    clear();
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x) {
+            if (grid.getCell(x, y) == CellState::ALIVE)
+                setCell(x, y, CellState::ALIVE);
+        }
+    }
+}
+
+void SparseUniverse::storeToGrid(Grid2D& grid) const
+{
+    grid.clear();
+    for (const auto& [key, chunk] : chunks) {
+        int64_t x0 = static_cast<int64_t>(static_cast<int32_t>(key >> 32)) * CHUNK_SIZE;
+        int64_t y0 = static_cast<int64_t>(static_cast<int32_t>(key & 0xFFFFFFFFu)) * CHUNK_SIZE;
+        if (x0 >= grid.getWidth() || y0 >= grid.getHeight() || x0 + CHUNK_SIZE <= 0 || y0 + CHUNK_SIZE <= 0)
+            continue;
+
+        for (int r = 0; r < CHUNK_SIZE; ++r) {
+            for (uint64_t row = chunk.rows[r]; row != 0; row &= row - 1) {
+                int64_t x = x0 + std::countr_zero(row);
+                int64_t y = y0 + r;
+                if (x >= 0 && y >= 0 && x < grid.getWidth() && y < grid.getHeight())
+                    grid.setCell(static_cast<int>(x), static_cast<int>(y), CellState::ALIVE);
+            }
+        }
+    }
+}
+
+uint64_t SparseUniverse::getPopulation() const
+{
+    uint64_t population = 0;
+    for (const auto& [key, chunk] : chunks) {
+        for (uint64_t row : chunk.rows) {
+            population += std::popcount(row);
+        }
+    }
+    return population;
+}
+
+size_t SparseUniverse::getMemoryUsage() const
+{
+    size_t entrySize = sizeof(Chunk) + sizeof(uint64_t) + 2 * sizeof(void*);
+    return chunks.size() * entrySize + chunks.bucket_count() * sizeof(void*);
+}
+
+const SparseUniverse::Chunk* SparseUniverse::find(int64_t cx, int64_t cy) const
+{
+    auto it = chunks.find(keyOf(cx, cy));
+    return it != chunks.end() ? &it->second : nullptr;
+}
+
+}  // namespace Core
@@ -0,0 +1,156 @@
+/**
+ * @file SparseUniverse.hpp
+ * @brief Universo ilimitado formado por bloques en una tabla hash
+ *
+ * Solo existen los bloques de 64x64 celdas con actividad: se crean cuando un
+ * patrón llega a su borde y se liberan cuando quedan vacíos, así que la
+ * memoria es proporcional al área viva y no a la caja que la contiene.
+ */
+
+#ifndef SPARSE_UNIVERSE_HPP
+#define SPARSE_UNIVERSE_HPP
+
+#include "Grid2D.hpp"
+#include "ThreadPool.hpp"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class SparseUniverse
+ * @brief Plano infinito de dos estados almacenado por bloques empaquetados
+ */
+class SparseUniverse {
+public:
+    // Lado de cada bloque (una palabra de 64 bits por fila)
+    static constexpr int CHUNK_SIZE = 64;
+
+    /**
+     * @brief Constructor (Conway por defecto)
+     */
+    SparseUniverse();
+
+    /**
+     * @brief Verifica si una regla puede simularse sin límites
+     * @param birthMask Máscara de nacimiento
+     * @return false si la regla tiene B0 (el vacío infinito se encendería)
+     */
+    static bool supportsRule(uint16_t birthMask) { return (birthMask & 1) == 0; }
+
+    /**
+     * @brief Establece la regla
+     * @param birthMask Bit n activo si una celda muerta nace con n vecinos
+     * @param survivalMask Bit n activo si una celda viva sobrevive con n vecinos
+     */
+    void setRule(uint16_t birthMask, uint16_t survivalMask);
+
+    /**
+     * @brief Elimina todos los bloques
+     */
+    void clear();
+
+    /**
+     * @brief Obtiene el estado de una celda
+     * @param x Coordenada X (cualquier valor)
+     * @param y Coordenada Y (cualquier valor)
+     * @return Estado de la celda
+     */
+    CellState getCell(int64_t x, int64_t y) const;
+
+    /**
+     * @brief Establece el estado de una celda (crea el bloque si hace falta)
+     * @param x Coordenada X
+     * @param y Coordenada Y
+     * @param state Nuevo estado
+     */
+    void setCell(int64_t x, int64_t y, CellState state);
+
+    /**
+     * @brief Avanza una generación
+     * @param pool Hilos para repartir los bloques (nullptr = en serie)
+     */
+    void step(ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Reemplaza el contenido por el de un grid (celda (x, y) = (x, y) del plano)
+     * @param grid Grid de origen
+     */
+    void loadFromGrid(const Grid2D& grid);
+
+    /**
+     * @brief Escribe en el grid la ventana [0, width) x [0, height) del plano
+     * @param grid Grid de destino
+     */
+    void storeToGrid(Grid2D& grid) const;
+
+    /**
+     * @brief Obtiene el número de bloques reservados
+     * @return Bloques
+     */
+    size_t getChunkCount() const { return chunks.size(); }
+
+    /**
+     * @brief Obtiene la población total
+     * @return Células vivas
+     */
+    uint64_t getPopulation() const;
+
+    /**
+     * @brief Estima la memoria usada por los bloques
+     * @return Bytes
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    /**
+     * @struct Chunk
+     * @brief Bloque de 64x64 celdas con su buffer de siguiente generación
+     */
+    struct Chunk {
+        std::array<uint64_t, CHUNK_SIZE> rows{};
+        std::array<uint64_t, CHUNK_SIZE> next{};
+        bool alive = false;  // Alguna celda viva tras el último paso
+    };
+
+    std::unordered_map<uint64_t, Chunk> chunks;
+    uint16_t birthMask;
+    uint16_t survivalMask;
+
+    /**
+     * @struct Work
+     * @brief Bloque a calcular con los punteros a las filas de sus 8 vecinos
+     */
+    struct Work {
+        Chunk* chunk;
+        const uint64_t* neighbors[8];
+    };
+
+    // Listas de trabajo reutilizadas entre pasos (se vacían al empezar cada uno)
+    std::vector<uint64_t> toCreate;
+    std::vector<Work> work;
+
+    /**
+     * @brief Empaqueta coordenadas de bloque en una clave
+     */
+    static uint64_t keyOf(int64_t cx, int64_t cy)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    /**
+     * @brief Coordenada de bloque (división hacia -infinito)
+     */
+    static int64_t chunkCoord(int64_t v) { return v >= 0 ? v / CHUNK_SIZE : (v - (CHUNK_SIZE - 1)) / CHUNK_SIZE; }
+
+    /**
+     * @brief Busca un bloque (nullptr si no existe)
+     */
+    const Chunk* find(int64_t cx, int64_t cy) const;
+};
+
+}  // namespace Core
+
+#endif  // SPARSE_UNIVERSE_HPP
@@ -0,0 +1,70 @@
+/**
+ * @file SpscQueue.hpp
+ * @brief Cola circular sin bloqueos de un productor y un consumidor
+ *
+ * El productor solo escribe head y el consumidor solo tail; cada uno lee el
+ * índice del otro con acquire para ver los elementos completos. Ninguna
+ * operación espera: push falla si la cola está llena y pop si está vacía.
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Core {
+
+/**
+ * @class SpscQueue
+ * @brief Cola acotada de Capacity - 1 elementos entre dos hilos
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity debe ser potencia de dos");
+
+public:
+    /**
+     * @brief Encola un elemento (solo hilo productor)
+     * @param value Elemento (se mueve solo si hay sitio)
+     * @return false si la cola está llena
+     */
+    bool push(T&& value)
+    {
+        size_t head = this->head.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & (Capacity - 1);
+        if (next == tail.load(std::memory_order_acquire))
+            return false;
+        slots[head] = std::move(value);
+        this->head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Desencola el elemento más antiguo (solo hilo consumidor)
+     * @param out Recibe el elemento
+     * @return false si la cola está vacía
+     */
+    bool pop(T& out)
+    {
+        size_t tail = this->tail.load(std::memory_order_relaxed);
+        if (tail == head.load(std::memory_order_acquire))
+            return false;
+        out = std::move(slots[tail]);
+        slots[tail] = T {};
+        this->tail.store((tail + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> slots;
+    // Índices en líneas de caché distintas: cada hilo escribe solo el suyo
+    alignas(64) std::atomic<size_t> head { 0 };
+    alignas(64) std::atomic<size_t> tail { 0 };
+};
+
+}  // namespace Core
+
+#endif  // SPSC_QUEUE_HPP
@@ -4,31 +4,51 @@
  */
 
 #include "Stats.hpp"
+#include "SimulationThread.hpp"
 #include <sstream>
 #include <iomanip>
 
 namespace Core {
 
-Stats::Stats() : population(0), fps(0.0f), fpsAccumulator(0.0f), frameCount(0) { }
+Stats::Stats() :
+    population(0), generationsPerSecond(0.0f), droppedAtWindowStart(0), droppedPerSecond(0.0f), fps(0.0f),
+    fpsAccumulator(0.0f), frameCount(0)
+{
+}
 
 void Stats::update(const Grid2D& grid, float deltaTime)
 {
-    // Calcular población
-    population = 0;
-    for (int y = 0; y < grid.getHeight(); ++y) {
-        for (int x = 0; x < grid.getWidth(); ++x) {
-            if (grid.getCell(x, y) == CellState::ALIVE) {
-                population++;
-            }
-        }
-    }
+    population = grid.getPopulation();
+    lastStep = grid.getLastStep();
+    updateFPS(deltaTime);
+}
 
-    // Calcular FPS
+void Stats::update(const Grid3D& grid, float deltaTime)
+{
+    population = grid.getPopulation();
+    lastStep = grid.getLastStep();
+    updateFPS(deltaTime);
+}
+
+void Stats::update(const SimulationSnapshot& snapshot, float deltaTime)
+{
+    population = snapshot.population;
+    lastStep = snapshot.lastStep;
+    cycle = snapshot.cycle;
+    generationsPerSecond = snapshot.generationsPerSecond;
+    updateReport = snapshot.updateReport;
+    updateFPS(deltaTime);
+}
+
+void Stats::updateFPS(float deltaTime)
+{
     frameCount++;
     fpsAccumulator += deltaTime;
 
     if (fpsAccumulator >= 1.0f) {
         fps = frameCount / fpsAccumulator;
+        droppedPerSecond = static_cast<float>(updateReport.dropped - droppedAtWindowStart) / fpsAccumulator;
+        droppedAtWindowStart = updateReport.dropped;
         frameCount = 0;
         fpsAccumulator = 0.0f;
     }
@@ -38,6 +58,14 @@ std::string Stats::toString() const
 {
     std::stringstream ss;
     ss << "Population: " << std::setw(4) << population << " | FPS: " << std::fixed << std::setprecision(1) << fps;
+    if (generationsPerSecond > 0.0f)
+        ss << " | Gen/s: " << generationsPerSecond;
+    if (updateReport.deferred > 0)
+        ss << " | Behind: " << updateReport.deferred;
+    if (droppedPerSecond > 0.0f)
+        ss << " | Dropped/s: " << droppedPerSecond;
+    if (cycle.isDetected())
+        ss << " | Period: " << cycle.period;
     return ss.str();
 }
 
@@ -8,11 +8,17 @@
 #ifndef STATS_HPP
 #define STATS_HPP
 
+#include "CycleDetector.hpp"
 #include "Grid2D.hpp"
+#include "Grid3D.hpp"
+#include "Simulator.hpp"
+#include <cstdint>
 #include <string>
 
 namespace Core {
 
+struct SimulationSnapshot;
+
 /**
  * @class Stats
  * @brief Calcula y mantiene estadísticas de la simulación
@@ -26,16 +32,80 @@ public:
 
     /**
      * @brief Actualiza estadísticas
+     *
+     * O(1): la población y los contadores del último paso los mantienen el
+     * grid y los kernels, sin recorrer las celdas.
+     *
      * @param grid Grid actual
      * @param deltaTime Tiempo del frame
      */
     void update(const Grid2D& grid, float deltaTime);
 
+    /**
+     * @brief Actualiza estadísticas de un grid 3D
+     * @param grid Grid actual
+     * @param deltaTime Tiempo del frame
+     */
+    void update(const Grid3D& grid, float deltaTime);
+
+    /**
+     * @brief Actualiza estadísticas desde la instantánea de un SimulationThread
+     *
+     * No toca el grid: la población, los contadores, el ciclo y el ritmo de
+     * la simulación salen de la última instantánea publicada.
+     *
+     * @param snapshot Instantánea
+     * @param deltaTime Tiempo del frame
+     */
+    void update(const SimulationSnapshot& snapshot, float deltaTime);
+
     /**
      * @brief Obtiene población actual
      * @return Número de células vivas
      */
-    int getPopulation() const { return population; }
+    int64_t getPopulation() const { return population; }
+
+    /**
+     * @brief Obtiene los contadores de la última generación
+     * @return Nacimientos, muertes y celdas cambiadas
+     */
+    const StepCounts& getLastStep() const { return lastStep; }
+
+    /**
+     * @brief Registra el ciclo detectado por el simulador
+     * @param info Ciclo (period == 0 si no hay)
+     */
+    void setCycle(const CycleInfo& info) { cycle = info; }
+
+    /**
+     * @brief Obtiene el ciclo en el que está el grid
+     * @return Ciclo (period == 0 si no hay)
+     */
+    const CycleInfo& getCycle() const { return cycle; }
+
+    /**
+     * @brief Registra los pasos aplazados y descartados por Simulator::update
+     * @param report Informe de la última actualización
+     */
+    void setUpdateReport(const UpdateReport& report) { updateReport = report; }
+
+    /**
+     * @brief Obtiene los pasos aplazados y descartados por Simulator::update
+     * @return Informe de la última actualización (dropped es acumulado)
+     */
+    const UpdateReport& getUpdateReport() const { return updateReport; }
+
+    /**
+     * @brief Obtiene el ritmo al que se descartan pasos por falta de tiempo
+     * @return Pasos descartados por segundo, medido junto a los FPS
+     */
+    float getDroppedPerSecond() const { return droppedPerSecond; }
+
+    /**
+     * @brief Obtiene el ritmo de la simulación (independiente de los FPS)
+     * @return Generaciones por segundo, o 0 si no se actualiza desde una instantánea
+     */
+    float getGenerationsPerSecond() const { return generationsPerSecond; }
 
     /**
      * @brief Obtiene FPS actual
@@ -50,10 +120,22 @@ public:
     std::string toString() const;
 
 private:
-    int population;
+    int64_t population;
+    StepCounts lastStep;
+    CycleInfo cycle;
+    float generationsPerSecond;
+    UpdateReport updateReport;
+    int64_t droppedAtWindowStart;  // updateReport.dropped al empezar la ventana de los FPS
+    float droppedPerSecond;
     float fps;
     float fpsAccumulator;
     int frameCount;
+
+    /**
+     * @brief Acumula el frame y recalcula los FPS cada segundo
+     * @param deltaTime Tiempo del frame
+     */
+    void updateFPS(float deltaTime);
 };
 
 }  // namespace Core
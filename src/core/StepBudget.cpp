@@ -0,0 +1,46 @@
+/**
+ * @file StepBudget.cpp
+ * @brief Implementación del límite de trabajo por llamada a update()
+ */
+
+#include "StepBudget.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Core {
+
+StepBudget clampStepBudget(const StepBudget& budget)
+{
+    StepBudget clamped;
+    clamped.maxSteps = std::max(budget.maxSteps, 1);
+    clamped.maxMilliseconds = std::max(budget.maxMilliseconds, 0.0f);
+    return clamped;
+}
+
+int takeDueSteps(float& accumulator, float interval, const StepBudget& budget, UpdateReport& report)
+{
+    // Tras un parón el tiempo debido no crece sin límite: lo que pasa de maxSteps intervalos se
+    // descarta en lugar de recuperarse con llamadas cada vez más largas
+    const float backlogLimit = static_cast<float>(budget.maxSteps) * interval;
+    if (accumulator > backlogLimit) {
+        float excess = accumulator - backlogLimit;
+        report.dropped += static_cast<int64_t>(excess / interval);
+        accumulator = backlogLimit + std::fmod(excess, interval);
+    }
+
+    int pendingSteps = 0;
+    while (accumulator >= interval) {
+        pendingSteps++;
+        accumulator -= interval;
+    }
+    return pendingSteps;
+}
+
+void deferSteps(float& accumulator, float interval, int pendingSteps, int executed, UpdateReport& report)
+{
+    report.executed = executed;
+    report.deferred = pendingSteps - executed;
+    accumulator += static_cast<float>(report.deferred) * interval;
+}
+
+}  // namespace Core
@@ -0,0 +1,69 @@
+/**
+ * @file StepBudget.hpp
+ * @brief Límite de trabajo de cada llamada a update() de los simuladores
+ *
+ * Tras un parón (ventana arrastrada, grid enorme) el tiempo acumulado no se
+ * recupera entero: se recorta a maxSteps intervalos y lo que sobra se
+ * descarta en lugar de encadenar llamadas cada vez más largas.
+ */
+
+#ifndef STEP_BUDGET_HPP
+#define STEP_BUDGET_HPP
+
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * @struct StepBudget
+ * @brief Trabajo máximo de una llamada a update()
+ */
+struct StepBudget {
+    int maxSteps = 256;             // Pasos por llamada; el tiempo debido no pasa de maxSteps intervalos
+    float maxMilliseconds = 10.0f;  // Tiempo de pasos por llamada (0 = sin límite); siempre se progresa algo
+};
+
+/**
+ * @struct UpdateReport
+ * @brief Pasos de la última llamada a update()
+ */
+struct UpdateReport {
+    int executed = 0;      // Pasos ejecutados
+    int deferred = 0;      // Pasos debidos que no cupieron en el tiempo y quedan para la siguiente llamada
+    int64_t dropped = 0;   // Pasos descartados al recortar el tiempo debido (acumulado desde el inicio)
+};
+
+/**
+ * @brief Ajusta un presupuesto a valores válidos
+ * @param budget Presupuesto pedido
+ * @return Presupuesto con maxSteps >= 1 y maxMilliseconds >= 0
+ */
+StepBudget clampStepBudget(const StepBudget& budget);
+
+/**
+ * @brief Saca del acumulador los pasos debidos, recortados a budget.maxSteps
+ *
+ * Lo que pasa de maxSteps intervalos se suma a report.dropped. Los pasos que
+ * luego no quepan en el tiempo se devuelven con deferSteps().
+ *
+ * @param accumulator Tiempo acumulado (se descuenta el de los pasos devueltos)
+ * @param interval Segundos por paso
+ * @param budget Límite de trabajo
+ * @param report Informe de la llamada (actualiza dropped)
+ * @return Pasos a ejecutar
+ */
+int takeDueSteps(float& accumulator, float interval, const StepBudget& budget, UpdateReport& report);
+
+/**
+ * @brief Anota los pasos ejecutados y devuelve al acumulador los que no cupieron
+ * @param accumulator Tiempo acumulado
+ * @param interval Segundos por paso
+ * @param pendingSteps Pasos que devolvió takeDueSteps()
+ * @param executed Pasos ejecutados
+ * @param report Informe de la llamada (actualiza executed y deferred)
+ */
+void deferSteps(float& accumulator, float interval, int pendingSteps, int executed, UpdateReport& report);
+
+}  // namespace Core
+
+#endif  // STEP_BUDGET_HPP
@@ -0,0 +1,144 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementación del pool de hilos
+ */
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Core {
+
+ThreadPool::ThreadPool(int threadCount, bool pinThreads) :
+    threadCount(threadCount), pinned(pinThreads), currentTask(nullptr), currentCount(0), jobId(0), pending(0),
+    stopping(false)
+{
+    if (this->threadCount <= 0) {
+        this->threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    workers.reserve(this->threadCount - 1);
+    for (int i = 1; i < this->threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int begin, int end)>& task)
+{
+    if (count <= 0)
+        return;
+
+    // El llamador procesa la banda 0 en el núcleo 0 (los trabajadores ocupan 1..n-1); se fija la primera
+    // vez que llama cada hilo, ya que el pool puede crearse en uno y usarse desde otro
+    if (pinned && callerThread != std::this_thread::get_id()) {
+        callerThread = std::this_thread::get_id();
+        pinCurrentThread(0);
+    }
+
+    const int threads = threadCount;
+    if (threads == 1 || count == 1) {
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        currentCount = count;
+        pending = static_cast<int>(workers.size());
+        jobId++;
+    }
+    wakeCondition.notify_all();
+
+    // El llamador procesa la banda 0
+    int end = static_cast<int>(static_cast<int64_t>(count) / threads);
+    if (end > 0)
+        task(0, end);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return pending == 0; });
+    currentTask = nullptr;
+}
+
+void ThreadPool::run(ThreadPool* pool, int count, const std::function<void(int begin, int end)>& task)
+{
+    if (pool) {
+        pool->parallelFor(count, task);
+    } else {
+        task(0, count);
+    }
+}
+
+void ThreadPool::workerLoop(int index)
+{
+    if (pinned) {
+        pinCurrentThread(index);
+    }
+
+    uint64_t lastJob = 0;
+    const int threads = threadCount;
+
+    while (true) {
+        const std::function<void(int, int)>* task;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || jobId != lastJob; });
+            if (stopping)
+                return;
+            lastJob = jobId;
+            task = currentTask;
+            count = currentCount;
+        }
+
+        int begin = static_cast<int>(static_cast<int64_t>(count) * index / threads);
+        int end = static_cast<int>(static_cast<int64_t>(count) * (index + 1) / threads);
+        if (begin < end)
+            (*task)(begin, end);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+            if (pending == 0)
+                doneCondition.notify_one();
+        }
+    }
+}
+
+void ThreadPool::pinCurrentThread(int core)
+{
+    int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    core %= cores;
+
+#if defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;  // Sin API de afinidad (macOS): el planificador decide
+#endif
+}
+
+}  // namespace Core
@@ -0,0 +1,107 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Pool de hilos persistente para dividir trabajo en bandas
+ *
+ * Los hilos se crean una sola vez y esperan trabajo; el hilo que llama a
+ * parallelFor también procesa su parte.
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class ThreadPool
+ * @brief Ejecuta un rango de índices repartido entre hilos persistentes
+ */
+class ThreadPool {
+public:
+    // Celdas por debajo de las cuales repartir un paso cuesta más de lo que ahorra
+    static constexpr int64_t PARALLEL_MIN_CELLS = 1 << 16;
+
+    /**
+     * @brief Constructor
+     * @param threadCount Hilos totales incluyendo al llamador (0 = núcleos disponibles)
+     * @param pinThreads true para fijar cada hilo a un núcleo (el llamador al 0)
+     */
+    explicit ThreadPool(int threadCount = 0, bool pinThreads = false);
+
+    /**
+     * @brief Destructor - Detiene y une los hilos
+     */
+    ~ThreadPool();
+
+    // Prevenir copia
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Obtiene el número de hilos (incluyendo al llamador)
+     * @return Número de hilos
+     */
+    int getThreadCount() const { return threadCount; }
+
+    /**
+     * @brief Verifica si los hilos están fijados a núcleos
+     * @return true si están fijados
+     */
+    bool isPinned() const { return pinned; }
+
+    /**
+     * @brief Reparte [0, count) en bandas contiguas y espera a que terminen
+     *
+     * El reparto solo depende de count y del número de hilos, nunca del
+     * orden de ejecución.
+     *
+     * @param count Número de elementos
+     * @param task Función llamada con cada banda [begin, end)
+     */
+    void parallelFor(int count, const std::function<void(int begin, int end)>& task);
+
+    /**
+     * @brief Ejecuta task sobre [0, count), repartido si hay hilos
+     * @param pool Hilos (nullptr = en serie en el hilo actual)
+     * @param count Número de elementos
+     * @param task Función llamada con cada banda [begin, end)
+     */
+    static void run(ThreadPool* pool, int count, const std::function<void(int begin, int end)>& task);
+
+private:
+    std::vector<std::thread> workers;
+    int threadCount;
+    bool pinned;
+    std::thread::id callerThread;  // Último llamador fijado al núcleo 0
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    const std::function<void(int, int)>* currentTask;
+    int currentCount;
+    uint64_t jobId;  // Se incrementa con cada parallelFor
+    int pending;     // Trabajadores que aún no terminan el trabajo actual
+    bool stopping;
+
+    /**
+     * @brief Bucle de cada hilo trabajador
+     * @param index Índice de banda del hilo (1..n-1, la 0 es del llamador)
+     */
+    void workerLoop(int index);
+
+    /**
+     * @brief Fija el hilo actual a un núcleo
+     * @param core Índice del núcleo
+     */
+    static void pinCurrentThread(int core);
+};
+
+}  // namespace Core
+
+#endif  // THREAD_POOL_HPP
@@ -0,0 +1,84 @@
+/**
+ * @file TripleBuffer.hpp
+ * @brief Triple buffer sin bloqueos entre un escritor y un lector
+ *
+ * El escritor rellena su buffer y lo publica intercambiándolo con el del
+ * medio; el lector, cuando hay uno nuevo, intercambia el suyo con el del
+ * medio. El intercambio es un único exchange atómico, así que ninguno de los
+ * dos espera nunca al otro: el escritor puede publicar más rápido de lo que
+ * el lector consume (los buffers intermedios se descartan) y el lector sigue
+ * viendo el último buffer tomado mientras no llegue otro.
+ */
+
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Core {
+
+/**
+ * @class TripleBuffer
+ * @brief Tres copias de T: la del escritor, la publicada y la del lector
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Buffer que el escritor está rellenando (solo hilo escritor)
+     * @return Referencia al buffer
+     */
+    T& getWriteBuffer() { return slots[writeIndex]; }
+
+    /**
+     * @brief Publica el buffer del escritor (solo hilo escritor)
+     *
+     * El escritor recibe el buffer que estaba en medio, con contenido antiguo:
+     * debe rellenarlo entero antes de la siguiente publicación.
+     */
+    void publish()
+    {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(writeIndex | FRESH), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Verifica si el lector ya tomó la última publicación (solo hilo escritor)
+     * @return true si no hay ninguna publicación pendiente de leer
+     */
+    bool isConsumed() const { return (middle.load(std::memory_order_acquire) & FRESH) == 0; }
+
+    /**
+     * @brief Toma la última publicación, si hay una nueva (solo hilo lector)
+     * @return true si getReadBuffer() cambió
+     */
+    bool acquire()
+    {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+            return false;
+        uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Última publicación tomada con acquire() (solo hilo lector)
+     * @return Referencia al buffer
+     */
+    const T& getReadBuffer() const { return slots[readIndex]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;  // El buffer del medio no se ha leído
+
+    std::array<T, 3> slots;
+    uint8_t writeIndex = 0;
+    uint8_t readIndex = 1;
+    std::atomic<uint8_t> middle { 2 };
+};
+
+}  // namespace Core
+
+#endif  // TRIPLE_BUFFER_HPP
@@ -2,21 +2,41 @@
  * @file main.cpp
  * @brief Motor de Simulación 3D - Punto de entrada
  *
- * Inicializa y ejecuta la aplicación principal.
+ * Inicializa y ejecuta la aplicación principal, o la simulación por lotes
+ * sin ventana con --headless (la única disponible sin SIMULATION_GUI).
  */
 
+#include "core/HeadlessRunner.hpp"
+#ifdef SIMULATION_GUI
 #include "core/Application.hpp"
+#endif
 #include <iostream>
+#include <stdexcept>
 
-int main()
+int main(int argc, char* argv[])
 {
     try {
-        Core::Application app(800, 600, "3D Universe Simulation");
+#ifdef SIMULATION_GUI
+        if (!Core::HeadlessRunner::hasFlag(argc, argv, "--headless") &&
+            !Core::HeadlessRunner::hasFlag(argc, argv, "--help")) {
+            Core::Application app(800, 600, "3D Universe Simulation");
 
-        app.init();
+            app.init();
 
-        app.run();
+            app.run();
+            return 0;
+        }
+#endif
+        if (Core::HeadlessRunner::hasFlag(argc, argv, "--help")) {
+            std::cout << Core::HeadlessRunner::getUsage();
+            return 0;
+        }
+        Core::HeadlessRunner runner(Core::HeadlessRunner::parseArguments(argc, argv));
+        runner.run();
 
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << "\n" << Core::HeadlessRunner::getUsage();
+        return 1;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
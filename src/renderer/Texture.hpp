@@ -45,6 +45,27 @@ public:
      */
     static GLuint loadFromFile(const std::string& fullPath);
 
+    /**
+     * @brief Crea una textura RGBA8 vacía para contenido que cambia cada frame
+     *
+     * Usa filtrado al vecino más cercano (sin mipmaps) para que cada celda
+     * se vea como un bloque nítido al ampliarla.
+     *
+     * @param width Ancho en píxeles
+     * @param height Alto en píxeles
+     * @return ID de la textura generada
+     */
+    static GLuint createDynamic(int width, int height);
+
+    /**
+     * @brief Sube un buffer RGBA8 completo a una textura creada con createDynamic
+     * @param textureID Textura destino
+     * @param rgba width * height * 4 bytes, fila 0 primero
+     * @param width Ancho en píxeles (el de la textura)
+     * @param height Alto en píxeles (el de la textura)
+     */
+    static void updateDynamic(GLuint textureID, const unsigned char* rgba, int width, int height);
+
 private:
     /**
      * @brief Genera una textura OpenGL a partir de datos raw de imagen
@@ -8,12 +8,13 @@
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
+#include <algorithm>
 
 namespace Renderer {
 
 UI::UI(GLFWwindow* window, const char* glsl_version) :
-    showStatsWindow(true), showControlsWindow(true), showVideoSettingsWindow(false), selectedResolutionIndex(0),
-    selectedDisplayModeIndex(0)
+    showStatsWindow(true), showControlsWindow(true), showVideoSettingsWindow(false), showGridWindow(true),
+    selectedResolutionIndex(0), selectedDisplayModeIndex(0), jumpGenerations(1000000)
 {
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -46,8 +47,11 @@ void UI::render()
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
-void UI::renderStatsPanel(Core::Simulator& simulator, Core::Stats& stats, Core::Grid2D& grid)
+void UI::renderStatsPanel(Core::SimulationThread& simulation, Core::Stats& stats)
 {
+    using Core::Grid2D;
+    using Core::Simulator;
+
     if (!showStatsWindow)
         return;
 
@@ -55,26 +59,163 @@ void UI::renderStatsPanel(Core::Simulator& simulator, Core::Stats& stats, Core::
     ImGui::SetNextWindowSize(ImVec2(300, 250), ImGuiCond_FirstUseEver);
 
     ImGui::Begin("Simulation Stats", &showStatsWindow);
+    const Core::SimulationSnapshot& snapshot = simulation.getSnapshot();
 
     // Información de la regla actual
-    Core::RuleType ruleType = simulator.getRuleType();
-    ImGui::Text("Rule: %s", Core::Rules::getName(ruleType).c_str());
+    ImGui::Text("Rule: %s", Core::Rules::getName(snapshot.rule).c_str());
+
+    // Regla personalizada en notación B/S o Larger than Life
+    static char ruleText[64] = "B3/S23";
+    static bool ruleError = false;
+    bool applyRule = ImGui::InputText("##rule", ruleText, sizeof(ruleText), ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    if (ImGui::Button("Set rule") || applyRule) {
+        std::optional<Core::Rule> rule = Core::Rules::parse(ruleText);
+        ruleError = !rule;
+        if (rule)
+            simulation.submit([rule = *rule](Simulator& simulator, Grid2D&) { simulator.setRule(rule); });
+    }
+    if (ruleError)
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Invalid rule (e.g. B36/S23, R5,C0,M1,S34..58,B34..45,NM)");
+
+    // Larger than Life: radio y forma del vecindario sobre la regla actual
+    const Core::Rule& currentRule = snapshot.rule;
+    if (currentRule.isLargerThanLife()) {
+        int radius = currentRule.radius;
+        int shape = static_cast<int>(currentRule.neighborhood);
+        const char* shapes[] = { "Moore", "von Neumann" };
+        bool radiusChanged = ImGui::SliderInt("Radius", &radius, 1, 20);
+        bool shapeChanged = ImGui::Combo("Neighborhood", &shape, shapes, IM_ARRAYSIZE(shapes));
+        if (radiusChanged || shapeChanged) {
+            Core::Rule rule = Core::Rules::makeLargerThanLife(
+                radius, static_cast<Core::Neighborhood>(shape), currentRule.includeCenter, currentRule.birthMin,
+                currentRule.birthMax, currentRule.survivalMin, currentRule.survivalMax, currentRule.states);
+            simulation.submit([rule](Simulator& simulator, Grid2D&) { simulator.setRule(rule); });
+        }
+    }
+
+    // Modo de borde (solo motor Grid)
+    int boundaryIndex = static_cast<int>(snapshot.boundary);
+    const char* boundaries[] = { Core::Grid2D::getBoundaryName(Core::BoundaryMode::DEAD),
+                                 Core::Grid2D::getBoundaryName(Core::BoundaryMode::TORUS),
+                                 Core::Grid2D::getBoundaryName(Core::BoundaryMode::MIRROR) };
+    if (ImGui::Combo("Boundary", &boundaryIndex, boundaries, IM_ARRAYSIZE(boundaries))) {
+        Core::BoundaryMode mode = static_cast<Core::BoundaryMode>(boundaryIndex);
+        simulation.submit([mode](Simulator& simulator, Grid2D&) { simulator.setBoundary(mode); });
+    }
+
+    // Selección de motor
+    int engineIndex = static_cast<int>(snapshot.engine);
+    const char* engines[] = { Core::Simulator::getEngineName(Core::EngineType::GRID),
+                              Core::Simulator::getEngineName(Core::EngineType::HASHLIFE),
+                              Core::Simulator::getEngineName(Core::EngineType::SPARSE),
+                              Core::Simulator::getEngineName(Core::EngineType::LENIA) };
+    if (ImGui::Combo("Engine", &engineIndex, engines, IM_ARRAYSIZE(engines))) {
+        Core::EngineType engine = static_cast<Core::EngineType>(engineIndex);
+        simulation.submit([engine](Simulator& simulator, Grid2D&) { simulator.setEngine(engine); });
+    }
+    if (snapshot.engine == Core::EngineType::HASHLIFE) {
+        int stepLog2 = snapshot.hashLifeStepLog2;
+        if (ImGui::SliderInt("Step 2^k", &stepLog2, 0, 20)) {
+            simulation.submit([stepLog2](Simulator& simulator, Grid2D&) { simulator.setHashLifeStepLog2(stepLog2); });
+        }
+        ImGui::Text("Nodes: %zu (%.1f MB)", snapshot.hashLifeNodes, snapshot.hashLifeMemory / (1024.0 * 1024.0));
+    } else if (snapshot.engine == Core::EngineType::SPARSE) {
+        ImGui::Text("Chunks: %zu (%.1f MB)", snapshot.sparseChunks, snapshot.sparseMemory / (1024.0 * 1024.0));
+        ImGui::Text("Total population: %llu", static_cast<unsigned long long>(snapshot.sparsePopulation));
+    } else if (snapshot.engine == Core::EngineType::LENIA) {
+        // Kernel de anillos y función de crecimiento (el coste no depende del radio)
+        Core::LeniaRule leniaRule = snapshot.leniaRule;
+        bool changed = ImGui::SliderInt("Kernel radius", &leniaRule.radius, Core::Lenia::MIN_RADIUS,
+                                        Core::Lenia::MAX_RADIUS);
+        changed |= ImGui::SliderFloat("Growth mu", &leniaRule.mu, 0.01f, 0.5f, "%.3f");
+        changed |= ImGui::SliderFloat("Growth sigma", &leniaRule.sigma, 0.001f, 0.1f, "%.4f");
+        changed |= ImGui::SliderFloat("Time step", &leniaRule.dt, 0.01f, 1.0f, "%.2f");
+        if (changed) {
+            simulation.submit([leniaRule](Simulator& simulator, Grid2D&) { simulator.setLeniaRule(leniaRule); });
+        }
+        if (ImGui::Button("Random field", ImVec2(-1, 0))) {
+            uint64_t seed = static_cast<uint64_t>(ImGui::GetFrameCount());
+            simulation.submit([seed](Simulator& simulator, Grid2D&) { simulator.randomizeLenia(0.5f, seed); });
+        }
+    } else {
+        // Bloqueo temporal: generaciones por pasada sobre cada bloque de tiles
+        int stepsPerPass = snapshot.stepsPerPass;
+        if (ImGui::SliderInt("Steps per pass", &stepsPerPass, 1, Core::Simulator::MAX_STEPS_PER_PASS)) {
+            simulation.submit(
+                [stepsPerPass](Simulator& simulator, Grid2D&) { simulator.setStepsPerPass(stepsPerPass); });
+        }
+    }
     ImGui::Separator();
 
     // Estadísticas
-    ImGui::Text("Generation: %d", simulator.getGeneration());
-    ImGui::Text("Population: %d / %d cells", stats.getPopulation(), grid.getWidth() * grid.getHeight());
+    ImGui::Text("Generation: %lld", static_cast<long long>(snapshot.generation));
+    const int64_t cellCount = static_cast<int64_t>(snapshot.width) * snapshot.height;
+    ImGui::Text("Population: %lld / %lld cells", static_cast<long long>(stats.getPopulation()),
+                static_cast<long long>(cellCount));
 
-    float density = (float)stats.getPopulation() / (grid.getWidth() * grid.getHeight()) * 100.0f;
+    float density = (float)stats.getPopulation() / cellCount * 100.0f;
     ImGui::Text("Density: %.1f%%", density);
+    const Core::StepCounts& lastStep = stats.getLastStep();
+    ImGui::Text("Births: %lld  Deaths: %lld  Changed: %lld", static_cast<long long>(lastStep.births),
+                static_cast<long long>(lastStep.deaths), static_cast<long long>(lastStep.changed));
+    ImGui::Text("Active tiles: %d / %d", snapshot.activeTiles, snapshot.tileCount);
+
+    // Ciclos: con el periodo conocido, cualquier generación posterior se alcanza sin simular
+    const Core::CycleInfo& cycle = stats.getCycle();
+    if (!cycle.isDetected()) {
+        ImGui::Text("Cycle: none");
+    } else if (cycle.period == 1) {
+        ImGui::Text("Cycle: still life since gen %lld", static_cast<long long>(cycle.startGeneration));
+    } else {
+        ImGui::Text("Cycle: period %lld since gen %lld", static_cast<long long>(cycle.period),
+                    static_cast<long long>(cycle.startGeneration));
+    }
+    bool autoFastForward = snapshot.autoFastForward;
+    if (ImGui::Checkbox("Auto fast-forward", &autoFastForward)) {
+        simulation.submit(
+            [autoFastForward](Simulator& simulator, Grid2D&) { simulator.setAutoFastForward(autoFastForward); });
+    }
+    if (cycle.isDetected()) {
+        ImGui::InputInt("Jump by", &jumpGenerations, 1000, 1000000);
+        jumpGenerations = std::max(jumpGenerations, 0);
+        if (ImGui::Button("Jump", ImVec2(-1, 0))) {
+            // Relativo a la generación en la que se ejecute la orden, no a la de la instantánea
+            int64_t generations = jumpGenerations;
+            simulation.submit([generations](Simulator& simulator, Grid2D&) {
+                simulator.fastForward(simulator.getGeneration() + generations);
+            });
+        }
+    }
 
     ImGui::Separator();
     ImGui::Text("FPS: %.1f", stats.getFPS());
+    ImGui::Text("Simulation: %.1f gen/s", stats.getGenerationsPerSecond());
+
+    // Presupuesto por actualización: por encima de lo que da la máquina se aplazan y descartan pasos
+    const Core::UpdateReport& report = stats.getUpdateReport();
+    bool behind = report.deferred > 0 || stats.getDroppedPerSecond() > 0.0f;
+    ImGui::TextColored(behind ? ImVec4(1, 0.5f, 0, 1) : ImVec4(1, 1, 1, 1), "Behind: %d steps  Dropped: %.0f/s (%lld)",
+                       report.deferred, stats.getDroppedPerSecond(), static_cast<long long>(report.dropped));
+    Core::StepBudget budget = snapshot.stepBudget;
+    bool budgetChanged = ImGui::SliderInt("Max steps/update", &budget.maxSteps, 1, 4096);
+    budgetChanged |= ImGui::SliderFloat("Max ms/update", &budget.maxMilliseconds, 1.0f, 50.0f, "%.1f");
+    if (budgetChanged)
+        simulation.submit([budget](Simulator& simulator, Grid2D&) { simulator.setStepBudget(budget); });
+
+    // Pasos reanudables: una generación más larga que el presupuesto se reparte entre actualizaciones
+    bool slicedStepping = snapshot.slicedStepping;
+    if (ImGui::Checkbox("Time-sliced steps", &slicedStepping)) {
+        simulation.submit(
+            [slicedStepping](Simulator& simulator, Grid2D&) { simulator.setSlicedStepping(slicedStepping); });
+    }
+    if (snapshot.stepProgress > 0.0f)
+        ImGui::ProgressBar(snapshot.stepProgress, ImVec2(-1, 0), "Next generation");
 
     // Estado de la simulación
     ImGui::Separator();
-    const char* status = simulator.isPaused() ? "PAUSED" : "RUNNING";
-    ImGui::TextColored(simulator.isPaused() ? ImVec4(1, 0.5f, 0, 1) : ImVec4(0, 1, 0, 1), "Status: %s", status);
+    const char* status = snapshot.paused ? "PAUSED" : "RUNNING";
+    ImGui::TextColored(snapshot.paused ? ImVec4(1, 0.5f, 0, 1) : ImVec4(0, 1, 0, 1), "Status: %s", status);
 
     // Botón para abrir configuración de video
     ImGui::Separator();
@@ -85,6 +226,25 @@ void UI::renderStatsPanel(Core::Simulator& simulator, Core::Stats& stats, Core::
     ImGui::End();
 }
 
+void UI::renderGridPanel(GLuint texture, int width, int height)
+{
+    if (!showGridWindow)
+        return;
+
+    ImGui::SetNextWindowPos(ImVec2(10, 270), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(300, 320), ImGuiCond_FirstUseEver);
+
+    ImGui::Begin("Grid", &showGridWindow);
+
+    // Escalar la textura al espacio disponible manteniendo la proporción de las celdas
+    ImVec2 available = ImGui::GetContentRegionAvail();
+    float scale = std::min(available.x / static_cast<float>(width), available.y / static_cast<float>(height));
+    if (scale > 0.0f)
+        ImGui::Image(static_cast<ImTextureID>(texture), ImVec2(width * scale, height * scale));
+
+    ImGui::End();
+}
+
 void UI::renderVideoSettingsPanel(Engine::Window& window)
 {
     if (!showVideoSettingsWindow) {
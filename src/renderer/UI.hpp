@@ -8,8 +8,8 @@
 #ifndef UI_HPP
 #define UI_HPP
 
-#include "core/Grid2D.hpp"
-#include "core/Simulator.hpp"
+#include <GL/glew.h>
+#include "core/SimulationThread.hpp"
 #include "core/Stats.hpp"
 #include "engine/Window.hpp"
 #include <GLFW/glfw3.h>
@@ -50,11 +50,22 @@ public:
 
     /**
      * @brief Renderiza panel de estadísticas
-     * @param simulator Referencia al simulador
+     *
+     * Los valores salen de la última instantánea y los cambios se envían como
+     * órdenes al hilo de simulación: el panel nunca espera a un paso.
+     *
+     * @param simulation Hilo de simulación
      * @param stats Referencia a estadísticas
-     * @param grid Referencia al grid
      */
-    void renderStatsPanel(Core::Simulator& simulator, Core::Stats& stats, Core::Grid2D& grid);
+    void renderStatsPanel(Core::SimulationThread& simulation, Core::Stats& stats);
+
+    /**
+     * @brief Renderiza panel con la textura del grid
+     * @param texture Textura RGBA del grid (ver Core::CellPalette)
+     * @param width Ancho del grid en celdas
+     * @param height Alto del grid en celdas
+     */
+    void renderGridPanel(GLuint texture, int width, int height);
 
     /**
      * @brief Renderiza panel de configuración de video
@@ -66,10 +77,14 @@ private:
     bool showStatsWindow;
     bool showControlsWindow;
     bool showVideoSettingsWindow;
+    bool showGridWindow;
 
     // Estado del selector de resolución
     int selectedResolutionIndex;
     int selectedDisplayModeIndex;
+
+    // Generaciones que avanza el botón de salto sobre un ciclo detectado
+    int jumpGenerations;
 };
 
 }  // namespace Renderer